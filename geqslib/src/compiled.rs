@@ -0,0 +1,798 @@
+use std::rc::Rc;
+use gmatlib::Matrix;
+use rayon::prelude::*;
+use crate::context::builtin_name;
+use crate::dual::Dual;
+use crate::errors::{EquationSolverError, ExpressionCompilationError, NewtonRaphsonSolverError, ShuntingYardError};
+use crate::newton::solve_in_place;
+use crate::shunting::{rpnify, get_legal_variables_iter, ContextHashMap, ContextLike, Token};
+
+/// The step size used when falling back to finite differences for
+/// user-registered context functions with no exact derivative rule.
+const _DX_: f64 = 0.001;
+
+/// A single operation in a compiled expression's flat bytecode.
+/// Deliberately not `PartialEq`: `Call` holds a `fn` pointer, and
+/// comparing those is unpredictable across codegen units.
+#[derive(Clone, Copy, Debug)]
+enum Instr
+{
+    /// Pushes a literal value onto the evaluation stack.
+    Push(f64),
+    /// Pushes the value of the numbered variable slot onto the stack.
+    Load(usize),
+    /// Pops the given number of arguments and pushes the function's result.
+    Call(usize, fn(&[f64]) -> f64),
+    Exp,
+    Div,
+    Mul,
+    Sub,
+    Add,
+}
+
+/// A string expression lowered to a flat bytecode over numbered variable
+/// slots.
+///
+/// # Concept:
+/// The token-stack evaluator behind `compile_to_fn_of_hashmap` reads every
+/// variable through an `Rc<RefCell<Variable>>` borrow and resolves every
+/// argument by hashing its `String` name on every call. A `CompiledExpr`
+/// pays those costs once, at compile time: each distinct variable is
+/// assigned a numbered slot, and evaluation reads straight out of a plain
+/// `&[f64]` with no interior mutability and no hashing. Solver loops that
+/// evaluate the same few hundred expressions thousands of times should
+/// prefer this form.
+///
+/// # Example
+/// ```
+/// use geqslib::compiled::CompiledExpr;
+/// use geqslib::shunting::{new_context, ContextLike};
+///
+/// let mut ctx = new_context();
+/// ctx.add_var_to_ctx("x", 4);
+/// ctx.add_var_to_ctx("y", 2);
+///
+/// let expr = CompiledExpr::compile("x + 4 * y", &ctx).unwrap();
+///
+/// // Values are passed positionally, in slot order:
+/// let mut slots = vec![0.0; expr.num_slots()];
+/// slots[expr.slot_of("x").unwrap()] = 8.0;
+/// slots[expr.slot_of("y").unwrap()] = 0.5;
+///
+/// assert_eq!(expr.eval(&slots).unwrap(), 10.0);
+/// ```
+#[derive(Clone, Debug)]
+pub struct CompiledExpr
+{
+    code: Vec<Instr>,
+    slots: Vec<String>,
+    max_stack: usize,
+}
+
+impl CompiledExpr
+{
+    /// Lowers a string expression to bytecode, assigning a numbered slot
+    /// to each distinct variable in order of first appearance. All
+    /// variables, constants, and functions in the expression must already
+    /// exist in the given `ContextHashMap`.
+    pub fn compile(expr: &str, context: &ContextHashMap) -> anyhow::Result<CompiledExpr>
+    {
+        // Ensure that all variables in the expression exist in the context
+        for var in get_legal_variables_iter(expr)
+        {
+            if !context.contains_key(var)
+            {
+                return Err(ExpressionCompilationError::VarNotFoundInContext.into());
+            }
+        }
+
+        let mut code = Vec::new();
+        let mut slots: Vec<String> = Vec::new();
+
+        for token in rpnify(expr, context)?
+        {
+            let instr = match token
+            {
+                Token::Num(num) => Instr::Push(num),
+                Token::Var(var) => {
+                    // Recover the variable's name by pointer identity so
+                    // aliased reads share a slot
+                    let name = context.iter()
+                        .find_map(|(name, tok)| match tok
+                        {
+                            Token::Var(other) if Rc::ptr_eq(&var, other) => Some(name),
+                            _ => None,
+                        })
+                        .ok_or(ExpressionCompilationError::VarNotFoundInContext)?;
+
+                    let slot = match slots.iter().position(|s| s == name)
+                    {
+                        Some(i) => i,
+                        None => {
+                            slots.push(name.to_owned());
+                            slots.len() - 1
+                        },
+                    };
+                    Instr::Load(slot)
+                },
+                Token::Func(args, func) => Instr::Call(args, func),
+                Token::Exp   => Instr::Exp,
+                Token::Div   => Instr::Div,
+                Token::Mul   => Instr::Mul,
+                Token::Minus => Instr::Sub,
+                Token::Plus  => Instr::Add,
+                _ => return Err(ShuntingYardError::LeftoverToken.into()),
+            };
+            code.push(instr);
+        }
+
+        // Validate stack discipline once here so eval never underflows
+        let mut depth: usize = 0;
+        let mut max_stack: usize = 0;
+        for instr in &code
+        {
+            let (pops, pushes) = match instr
+            {
+                Instr::Push(_) | Instr::Load(_) => (0, 1),
+                Instr::Call(args, _) => (*args, 1),
+                _ => (2, 1),
+            };
+            if depth < pops
+            {
+                return Err(ShuntingYardError::ExpectedArg.into());
+            }
+            depth = depth - pops + pushes;
+            max_stack = max_stack.max(depth);
+        }
+        if depth != 1
+        {
+            return Err(if depth == 0
+            {
+                ShuntingYardError::NoTokens.into()
+            }
+            else
+            {
+                ShuntingYardError::LeftoverToken.into()
+            });
+        }
+
+        Ok(CompiledExpr { code, slots, max_stack })
+    }
+
+    /// Returns the number of variable slots the expression reads.
+    pub fn num_slots(&self) -> usize
+    {
+        self.slots.len()
+    }
+
+    /// Returns the slot names in slot order.
+    pub fn slot_names(&self) -> &[String]
+    {
+        &self.slots
+    }
+
+    /// Returns the slot index assigned to the named variable, if the
+    /// expression reads it.
+    pub fn slot_of(&self, name: &str) -> Option<usize>
+    {
+        self.slots.iter().position(|s| s == name)
+    }
+
+    /// Evaluates the bytecode against a plain slot array, where
+    /// `slots[i]` is the value of the variable named `slot_names()[i]`.
+    pub fn eval(&self, slots: &[f64]) -> anyhow::Result<f64>
+    {
+        let mut stack = Vec::with_capacity(self.max_stack);
+        self.eval_with_scratch(slots, &mut stack)
+    }
+
+    /// Like `eval`, but reuses a caller-provided stack buffer so repeated
+    /// evaluation in a solver inner loop performs no allocations at all.
+    pub fn eval_with_scratch(&self, slots: &[f64], stack: &mut Vec<f64>) -> anyhow::Result<f64>
+    {
+        stack.clear();
+
+        for instr in &self.code
+        {
+            match instr
+            {
+                Instr::Push(num) => stack.push(*num),
+
+                Instr::Load(slot) => stack.push(slots[*slot]),
+
+                Instr::Call(args, func) => {
+                    // Arguments are passed in pop order to match the
+                    // token-stack evaluator's calling convention
+                    let split = stack.len() - args;
+                    stack[split..].reverse();
+                    let result = func(&stack[split..]);
+                    stack.truncate(split);
+                    stack.push(result);
+                },
+
+                Instr::Exp => {
+                    let (arg2, arg1) = (stack.pop().unwrap(), stack.pop().unwrap());
+                    stack.push(arg1.powf(arg2));
+                },
+
+                Instr::Div => {
+                    let (arg2, arg1) = (stack.pop().unwrap(), stack.pop().unwrap());
+                    if arg2 == 0.0
+                    {
+                        return Err(ShuntingYardError::DivisionByZero.into());
+                    }
+                    stack.push(arg1 / arg2);
+                },
+
+                Instr::Mul => {
+                    let (arg2, arg1) = (stack.pop().unwrap(), stack.pop().unwrap());
+                    stack.push(arg1 * arg2);
+                },
+
+                Instr::Sub => {
+                    let (arg2, arg1) = (stack.pop().unwrap(), stack.pop().unwrap());
+                    stack.push(arg1 - arg2);
+                },
+
+                Instr::Add => {
+                    let (arg2, arg1) = (stack.pop().unwrap(), stack.pop().unwrap());
+                    stack.push(arg1 + arg2);
+                },
+            }
+        }
+
+        Ok(stack[0])
+    }
+
+    /// Evaluates the bytecode over dual numbers, returning the value of
+    /// the expression and its EXACT partial derivative with respect to
+    /// the variable in slot `wrt` in a single pass. Built-in context
+    /// functions are differentiated by their analytic rules; functions
+    /// registered by the caller fall back to central finite differences.
+    ///
+    /// # Example
+    /// ```
+    /// use geqslib::compiled::CompiledExpr;
+    /// use geqslib::shunting::{new_context, ContextLike};
+    ///
+    /// let mut ctx = new_context();
+    /// ctx.add_var_to_ctx("x", 0.0);
+    ///
+    /// let expr = CompiledExpr::compile("x ^ 2 + 3 * x", &ctx).unwrap();
+    /// let d = expr.eval_dual(&[2.0], 0).unwrap();
+    ///
+    /// assert_eq!(d.val, 10.0);
+    /// assert_eq!(d.dot, 7.0); // exact, not a finite difference
+    /// ```
+    pub fn eval_dual(&self, slots: &[f64], wrt: usize) -> anyhow::Result<Dual>
+    {
+        let mut stack = Vec::with_capacity(self.max_stack);
+        self.eval_dual_with_scratch(slots, wrt, &mut stack)
+    }
+
+    /// Like `eval_dual`, but reuses a caller-provided stack buffer so
+    /// Jacobian assembly loops perform no allocations.
+    pub fn eval_dual_with_scratch(&self, slots: &[f64], wrt: usize, stack: &mut Vec<Dual>) -> anyhow::Result<Dual>
+    {
+        stack.clear();
+
+        for instr in &self.code
+        {
+            match instr
+            {
+                Instr::Push(num) => stack.push(Dual::constant(*num)),
+
+                Instr::Load(slot) => stack.push(Dual::new(
+                    slots[*slot],
+                    if *slot == wrt { 1.0 } else { 0.0 }
+                )),
+
+                Instr::Call(args, func) => {
+                    // Arguments are passed in pop order to match the
+                    // token-stack evaluator's calling convention
+                    let split = stack.len() - args;
+                    stack[split..].reverse();
+                    let result = call_dual(*func, &stack[split..]);
+                    stack.truncate(split);
+                    stack.push(result);
+                },
+
+                Instr::Exp => {
+                    let (arg2, arg1) = (stack.pop().unwrap(), stack.pop().unwrap());
+                    stack.push(arg1.powf(arg2));
+                },
+
+                Instr::Div => {
+                    let (arg2, arg1) = (stack.pop().unwrap(), stack.pop().unwrap());
+                    if arg2.val == 0.0
+                    {
+                        return Err(ShuntingYardError::DivisionByZero.into());
+                    }
+                    stack.push(arg1 / arg2);
+                },
+
+                Instr::Mul => {
+                    let (arg2, arg1) = (stack.pop().unwrap(), stack.pop().unwrap());
+                    stack.push(arg1 * arg2);
+                },
+
+                Instr::Sub => {
+                    let (arg2, arg1) = (stack.pop().unwrap(), stack.pop().unwrap());
+                    stack.push(arg1 - arg2);
+                },
+
+                Instr::Add => {
+                    let (arg2, arg1) = (stack.pop().unwrap(), stack.pop().unwrap());
+                    stack.push(arg1 + arg2);
+                },
+            }
+        }
+
+        Ok(stack[0])
+    }
+
+    /// Evaluates the expression and writes its partial derivative with
+    /// respect to every slot into `grad`, returning the value. `grad`
+    /// must hold `num_slots` elements.
+    pub fn eval_grad(&self, slots: &[f64], grad: &mut [f64]) -> anyhow::Result<f64>
+    {
+        // A constant expression has no slots to differentiate against,
+        // but its value must still be reported
+        if self.slots.is_empty()
+        {
+            return self.eval(slots);
+        }
+
+        let mut stack = Vec::with_capacity(self.max_stack);
+        let mut val = 0.0;
+
+        for wrt in 0..self.slots.len()
+        {
+            let d = self.eval_dual_with_scratch(slots, wrt, &mut stack)?;
+            grad[wrt] = d.dot;
+            val = d.val;
+        }
+
+        Ok(val)
+    }
+}
+
+/// Applies a context function to dual-number arguments given in pop
+/// order, using the analytic derivative rule for the functions that
+/// `new_context` installs and central finite differences for anything
+/// registered by the caller.
+fn call_dual(func: fn(&[f64]) -> f64, args: &[Dual]) -> Dual
+{
+    if let Some(name) = builtin_name(func)
+    {
+        let x = args[0];
+        match name
+        {
+            "sin"    => return Dual::new(x.val.sin(), x.val.cos() * x.dot),
+            "cos"    => return Dual::new(x.val.cos(), -x.val.sin() * x.dot),
+            "tan"    => {
+                let sec2 = 1.0 / (x.val.cos() * x.val.cos());
+                return Dual::new(x.val.tan(), sec2 * x.dot);
+            },
+            "arcsin" => return Dual::new(x.val.asin(), x.dot / (1.0 - x.val * x.val).sqrt()),
+            "arccos" => return Dual::new(x.val.acos(), -x.dot / (1.0 - x.val * x.val).sqrt()),
+            "arctan" => return Dual::new(x.val.atan(), x.dot / (1.0 + x.val * x.val)),
+            "sinh"   => return Dual::new(x.val.sinh(), x.val.cosh() * x.dot),
+            "cosh"   => return Dual::new(x.val.cosh(), x.val.sinh() * x.dot),
+            "tanh"   => {
+                let t = x.val.tanh();
+                return Dual::new(t, (1.0 - t * t) * x.dot);
+            },
+            "ln"     => return Dual::new(x.val.ln(), x.dot / x.val),
+            "log10"  => return Dual::new(x.val.log10(), x.dot / (x.val * std::f64::consts::LN_10)),
+            "abs"    => return Dual::new(x.val.abs(), x.val.signum() * x.dot),
+            "log"    => {
+                // Matches context::log, which reads its operand in
+                // args[0] and its base in args[1]
+                let base = args[1];
+                let ln_base = base.val.ln();
+                return Dual::new(
+                    x.val.log(base.val),
+                    x.dot / (x.val * ln_base)
+                        - base.dot * x.val.ln() / (base.val * ln_base * ln_base)
+                );
+            },
+            "if"     => {
+                // Matches context::conditional: the derivative is that
+                // of whichever branch the predicate selects
+                let decision = match args[3].val.round() as usize
+                {
+                    1 => args[4].val == args[2].val,
+                    2 => args[4].val <= args[2].val,
+                    3 => args[4].val >= args[2].val,
+                    4 => args[4].val <  args[2].val,
+                    5 => args[4].val >  args[2].val,
+                    _ => args[4].val != args[2].val,
+                };
+                return if decision { args[1] } else { args[0] };
+            },
+            _ => (),
+        }
+    }
+
+    // An unknown user-registered function: evaluate once and accumulate
+    // a central finite difference for each argument it depends on
+    let mut vals: Vec<f64> = args.iter().map(|d| d.val).collect();
+    let val = func(&vals);
+    let mut dot = 0.0;
+
+    for (i, arg) in args.iter().enumerate()
+    {
+        if arg.dot == 0.0
+        {
+            continue;
+        }
+        vals[i] += _DX_;
+        let hi = func(&vals);
+        vals[i] -= 2.0 * _DX_;
+        let lo = func(&vals);
+        vals[i] += _DX_;
+        dot += (hi - lo) / (2.0 * _DX_) * arg.dot;
+    }
+
+    Dual::new(val, dot)
+}
+
+/// A table interning variable names to dense indices.
+///
+/// Interning happens once, when a system is compiled; afterwards every
+/// read and write of solver state is a plain slice index with no hashing.
+#[derive(Clone, Debug, Default)]
+pub struct VariableTable
+{
+    names: Vec<String>,
+    index: std::collections::HashMap<String, usize>,
+}
+
+impl VariableTable
+{
+    /// Creates an empty table.
+    pub fn new() -> VariableTable
+    {
+        VariableTable::default()
+    }
+
+    /// Returns the dense index for `name`, assigning the next free index
+    /// if the name has not been seen before.
+    pub fn intern(&mut self, name: &str) -> usize
+    {
+        if let Some(&i) = self.index.get(name)
+        {
+            return i;
+        }
+        let i = self.names.len();
+        self.names.push(name.to_owned());
+        self.index.insert(name.to_owned(), i);
+        i
+    }
+
+    /// Returns the dense index assigned to `name`, if any.
+    pub fn index_of(&self, name: &str) -> Option<usize>
+    {
+        self.index.get(name).copied()
+    }
+
+    /// Returns the interned names in index order.
+    pub fn names(&self) -> &[String]
+    {
+        &self.names
+    }
+
+    /// Returns the number of interned names.
+    pub fn len(&self) -> usize
+    {
+        self.names.len()
+    }
+
+    /// Returns `true` if no names have been interned.
+    pub fn is_empty(&self) -> bool
+    {
+        self.names.is_empty()
+    }
+}
+
+/// A fully-constrained system of equations lowered to bytecode with all
+/// solver state in one contiguous `Vec<f64>`.
+///
+/// # Concept:
+/// `System::solve` keeps its guess vector in a `HashMap<String, f64>`
+/// that is hashed into on every variable read of every residual
+/// evaluation. A `CompiledSystem` interns each variable into a
+/// `VariableTable` once at compile time and addresses the iteration
+/// state by dense index from then on; names only matter again at the
+/// API boundary when guesses are set and results are returned. The
+/// Jacobian is assembled with the exact dual-number evaluator rather
+/// than finite differences.
+///
+/// # Example
+/// ```
+/// use geqslib::compiled::CompiledSystem;
+/// use geqslib::shunting::new_context;
+///
+/// let mut sys = CompiledSystem::compile(
+///     &["x + y = 9", "x - y = 4"],
+///     &new_context()
+/// ).unwrap();
+///
+/// let soln = sys.solve(0.0001, 50).unwrap();
+///
+/// assert!((soln["x"] - 6.5).abs() < 0.001);
+/// assert!((soln["y"] - 2.5).abs() < 0.001);
+/// ```
+#[derive(Clone)]
+pub struct CompiledSystem
+{
+    vars: VariableTable,
+    exprs: Vec<CompiledExpr>,
+    slot_maps: Vec<Vec<usize>>,
+    state: Vec<f64>,
+}
+
+impl CompiledSystem
+{
+    /// Compiles a set of equations against a context, interning every
+    /// unknown into the system's `VariableTable`. Unknowns receive a
+    /// default guess of `1.0` until `set_guess` says otherwise.
+    pub fn compile(equations: &[&str], context: &ContextHashMap) -> anyhow::Result<CompiledSystem>
+    {
+        let mut ctx = context.clone();
+        let mut vars = VariableTable::new();
+        let mut exprs = Vec::with_capacity(equations.len());
+        let mut slot_maps = Vec::with_capacity(equations.len());
+
+        for equation in equations
+        {
+            // Rearrange each equation to a residual expression
+            let sides: Vec<&str> = equation.split('=').collect();
+            match sides.len()
+            {
+                1 => return Err(EquationSolverError::FoundExpression.into()),
+                2 => (),
+                _ => return Err(EquationSolverError::FoundMultipleEquations.into()),
+            }
+            let residual = format!("{} - ({})", sides[0], sides[1]);
+
+            // Register unknowns in the context with a default guess so
+            // the expression compiles
+            for var in get_legal_variables_iter(&residual)
+            {
+                if !ctx.contains_key(var)
+                {
+                    ctx.add_var_to_ctx(var, 1.0);
+                }
+            }
+
+            let expr = CompiledExpr::compile(&residual, &ctx)?;
+            let map = expr.slot_names()
+                .iter()
+                .map(|name| vars.intern(name))
+                .collect();
+
+            exprs.push(expr);
+            slot_maps.push(map);
+        }
+
+        // Seed the dense state from the context's variable values
+        let mut state = vec![1.0; vars.len()];
+        for (i, name) in vars.names().iter().enumerate()
+        {
+            if let Some(Token::Var(var)) = ctx.get(name)
+            {
+                state[i] = (*var.borrow()).into();
+            }
+        }
+
+        Ok(CompiledSystem { vars, exprs, slot_maps, state })
+    }
+
+    /// Gives read access to the system's interned variable names.
+    pub fn var_table(&self) -> &VariableTable
+    {
+        &self.vars
+    }
+
+    /// Sets the initial guess for the named variable, returning `false`
+    /// if the system has no such unknown.
+    pub fn set_guess(&mut self, var: &str, guess: f64) -> bool
+    {
+        match self.vars.index_of(var)
+        {
+            Some(i) => {
+                self.state[i] = guess;
+                true
+            },
+            None => false,
+        }
+    }
+
+    /// Tries to solve the system to within `margin` of the actual
+    /// solution in at most `limit` Newton iterations. Variable names are
+    /// only consulted here, at the boundary, to build the result map;
+    /// the iteration itself runs entirely over dense indices.
+    pub fn solve(&mut self, margin: f64, limit: usize) -> anyhow::Result<std::collections::HashMap<String, f64>>
+    {
+        // Catch illegal margin of error
+        if margin <= 0.0
+        {
+            return Err(NewtonRaphsonSolverError::NegativeMargin.into());
+        }
+
+        let n = self.vars.len();
+        if self.exprs.len() != n
+        {
+            return Err(NewtonRaphsonSolverError::ImproperlyConstrainedSystem.into());
+        }
+
+        let mut jacobian: Matrix<f64> = Matrix::new(n, n);
+        let mut y = vec![0.0; n];
+        let mut gather = Vec::new();
+        let mut scratch = Vec::new();
+
+        for _ in 0..limit
+        {
+            // Evaluate each residual and its exact partials in one pass
+            // over the expression's own slots
+            for (i, expr) in self.exprs.iter().enumerate()
+            {
+                let map = &self.slot_maps[i];
+                gather.clear();
+                gather.extend(map.iter().map(|&idx| self.state[idx]));
+
+                for (slot, &idx) in map.iter().enumerate()
+                {
+                    let d = expr.eval_dual_with_scratch(&gather, slot, &mut scratch)?;
+                    jacobian[(i, idx)] = d.dot;
+                    y[i] = d.val;
+                }
+            }
+            let error = y.iter()
+                .map(|v| v.powi(2))
+                .sum::<f64>();
+
+            // Calculate change vector and its magnitude
+            let mut deltas = std::mem::take(&mut y);
+            solve_in_place(&mut jacobian, &mut deltas)?;
+            let change = deltas.iter()
+                .map(|d| d.powi(2))
+                .sum::<f64>()
+                .sqrt();
+
+            let converged = error <= margin && change <= margin;
+
+            if !converged
+            {
+                // Build next guess vector
+                for i in 0..n
+                {
+                    self.state[i] -= deltas[i];
+                }
+            }
+            y = deltas;
+
+            if converged
+            {
+                let mut soln = std::collections::HashMap::with_capacity(n);
+                for (i, name) in self.vars.names().iter().enumerate()
+                {
+                    soln.insert(name.clone(), self.state[i]);
+                }
+                return Ok(soln);
+            }
+
+            // The jacobian is overwritten by the elimination; zero it so
+            // sparse rows do not inherit stale factors next iteration
+            for i in 0..n
+            {
+                for j in 0..n
+                {
+                    jacobian[(i, j)] = 0.0;
+                }
+            }
+        }
+
+        Err(NewtonRaphsonSolverError::ReachedIterationLimit.into())
+    }
+
+    /// Like `solve`, but distributes residual and Jacobian row evaluation
+    /// across the rayon thread pool. Each equation owns exactly one
+    /// residual entry and one Jacobian row, so the rows are filled on
+    /// separate cores with no shared mutable state: the bytecode holds no
+    /// `Rc` or `RefCell`, and every task evaluates against its own stack
+    /// buffers. Worth the scheduling overhead once a system has more than
+    /// a few dozen equations; below that, prefer `solve`.
+    pub fn solve_parallel(&mut self, margin: f64, limit: usize) -> anyhow::Result<std::collections::HashMap<String, f64>>
+    {
+        // Catch illegal margin of error
+        if margin <= 0.0
+        {
+            return Err(NewtonRaphsonSolverError::NegativeMargin.into());
+        }
+
+        let n = self.vars.len();
+        if self.exprs.len() != n
+        {
+            return Err(NewtonRaphsonSolverError::ImproperlyConstrainedSystem.into());
+        }
+
+        let mut jacobian: Matrix<f64> = Matrix::new(n, n);
+        let mut rows = vec![vec![0.0; n]; n];
+        let mut y = vec![0.0; n];
+
+        for _ in 0..limit
+        {
+            // Fan the n * (n + 1) expression evaluations out across cores,
+            // one task per equation
+            let state = &self.state;
+            self.exprs.par_iter()
+                .zip(&self.slot_maps)
+                .zip(rows.par_iter_mut().zip(y.par_iter_mut()))
+                .try_for_each(|((expr, map), (row, res))| -> anyhow::Result<()>
+                {
+                    let gather: Vec<f64> = map.iter().map(|&idx| state[idx]).collect();
+                    let mut scratch = Vec::new();
+
+                    for v in row.iter_mut()
+                    {
+                        *v = 0.0;
+                    }
+                    for (slot, &idx) in map.iter().enumerate()
+                    {
+                        let d = expr.eval_dual_with_scratch(&gather, slot, &mut scratch)?;
+                        row[idx] = d.dot;
+                        *res = d.val;
+                    }
+                    Ok(())
+                })?;
+
+            // Scatter the finished rows into the matrix, fully overwriting
+            // whatever the previous elimination left behind
+            for (i, row) in rows.iter().enumerate()
+            {
+                for (j, &v) in row.iter().enumerate()
+                {
+                    jacobian[(i, j)] = v;
+                }
+            }
+            let error = y.iter()
+                .map(|v| v.powi(2))
+                .sum::<f64>();
+
+            // Calculate change vector and its magnitude
+            let mut deltas = std::mem::take(&mut y);
+            solve_in_place(&mut jacobian, &mut deltas)?;
+            let change = deltas.iter()
+                .map(|d| d.powi(2))
+                .sum::<f64>()
+                .sqrt();
+
+            let converged = error <= margin && change <= margin;
+
+            if !converged
+            {
+                // Build next guess vector
+                for i in 0..n
+                {
+                    self.state[i] -= deltas[i];
+                }
+            }
+            y = deltas;
+
+            if converged
+            {
+                let mut soln = std::collections::HashMap::with_capacity(n);
+                for (i, name) in self.vars.names().iter().enumerate()
+                {
+                    soln.insert(name.clone(), self.state[i]);
+                }
+                return Ok(soln);
+            }
+        }
+
+        Err(NewtonRaphsonSolverError::ReachedIterationLimit.into())
+    }
+}
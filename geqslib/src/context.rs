@@ -91,6 +91,34 @@ fn conditional(args: &[f64]) -> f64 {
     }
 }
 
+/// Recovers the name of a built-in context function from its pointer.
+/// This lets the differentiating evaluator apply exact derivative rules
+/// to the functions installed by `new_context` while treating any
+/// user-registered function as a black box.
+pub (in crate) fn builtin_name(func: fn(&[f64]) -> f64) -> Option<&'static str>
+{
+    let builtins: [(fn(&[f64]) -> f64, &'static str); 14] = [
+        (conditional, "if"),
+        (sin,         "sin"),
+        (cos,         "cos"),
+        (tan,         "tan"),
+        (arcsin,      "arcsin"),
+        (arccos,      "arccos"),
+        (arctan,      "arctan"),
+        (sinh,        "sinh"),
+        (cosh,        "cosh"),
+        (tanh,        "tanh"),
+        (ln,          "ln"),
+        (log10,       "log10"),
+        (log,         "log"),
+        (abs,         "abs"),
+    ];
+
+    builtins.iter()
+        .find(|(f, _)| std::ptr::fn_addr_eq(*f, func))
+        .map(|(_, name)| *name)
+}
+
 /// A module for sealing the `ContextLike` trait.
 pub (crate) mod private
 {
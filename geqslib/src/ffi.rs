@@ -1,7 +1,11 @@
 use std::ffi::{c_char, c_int, c_void, c_double, c_uint, CStr, CString};
 use std::panic::catch_unwind;
 use std::ptr::{null, copy_nonoverlapping};
+use std::slice;
 
+use rayon::prelude::*;
+
+use crate::compiled::CompiledSystem;
 use crate::shunting::{ContextHashMap, new_context, ContextLike};
 use crate::solve_equation_with_context;
 use crate::system::{System, SystemBuilder, ConstrainResult};
@@ -263,4 +267,190 @@ pub unsafe extern "C" fn free_system(p_system: *mut c_void)
 pub unsafe extern "C" fn free_solution_string(soln_str: *mut c_char)
 {
     let _owned = CString::from_raw(soln_str);
-}
\ No newline at end of file
+}
+/// Compiles a system of equations ONCE to an opaque handle that can be
+/// solved any number of times with different inputs. `equations` is an
+/// array of `count` nul-terminated equation strings and `context` is a
+/// `ContextHashMap` pointer from `new_default_context_hash_map` or
+/// similar. Returns `NULL` if compilation fails.
+///
+/// Unlike `solve_system`, the handle is NOT consumed by solving; it must
+/// be freed with `free_compiled_system` when no longer needed.
+#[no_mangle]
+pub extern "C" fn compile_system(equations: *const *const c_char, count: c_uint, context: *const c_void) -> *const c_void
+{
+    let res = catch_unwind(|| {
+        let equation_strs: Vec<String> = unsafe
+        {
+            slice::from_raw_parts(equations, count as usize)
+                .iter()
+                .map(|&s| new_owned_string(s))
+                .collect()
+        };
+        let equation_refs: Vec<&str> = equation_strs.iter()
+            .map(|s| s.as_str())
+            .collect();
+
+        let ctx = unsafe { &*(context as *const ContextHashMap) };
+
+        let system = match CompiledSystem::compile(&equation_refs, ctx)
+        {
+            Ok(s) => s,
+            Err(_) => return null(),
+        };
+
+        leak_object(system)
+    });
+
+    match res
+    {
+        Ok(p) => p as *const c_void,
+        Err(_) => null(),
+    }
+}
+
+/// Returns the number of unknowns in the compiled system at the given
+/// handle, or `-1` on error. This is the length of the input and output
+/// arrays expected by `solve_compiled_system`.
+#[no_mangle]
+pub extern "C" fn compiled_system_var_count(p_system: *const c_void) -> c_int
+{
+    let res = catch_unwind(|| {
+        unsafe { (*(p_system as *const CompiledSystem)).var_table().len() as c_int }
+    });
+
+    res.unwrap_or(-1)
+}
+
+/// Returns the name of unknown `i` in the compiled system at the given
+/// handle as a nul-terminated C `char *`, or `NULL` if `i` is out of
+/// range. Inputs and outputs passed to `solve_compiled_system` use this
+/// ordering. Free the returned string with `free_solution_string`.
+#[no_mangle]
+pub extern "C" fn compiled_system_var_name(p_system: *const c_void, i: c_uint) -> *const c_char
+{
+    let res = catch_unwind(|| {
+        let system = unsafe { &*(p_system as *const CompiledSystem) };
+
+        match system.var_table().names().get(i as usize)
+        {
+            Some(name) => CString::new(name.as_str())
+                .expect("failed to create C-compatible variable name string!")
+                .into_raw() as *const c_char,
+            None => null(),
+        }
+    });
+
+    match res
+    {
+        Ok(s) => s,
+        Err(_) => null(),
+    }
+}
+
+/// Solves the compiled system at the given handle, reading initial
+/// guesses from `values` and writing the solution back over them on
+/// success. `values` must hold `n` doubles in `compiled_system_var_name`
+/// order, where `n` matches `compiled_system_var_count`.
+///
+/// The returned C `int` value indicates the following:
+/// - `1`: The system was solved and `values` holds the solution
+/// - `-1`: The solve failed; `values` is left untouched
+#[no_mangle]
+pub extern "C" fn solve_compiled_system(p_system: *mut c_void, values: *mut c_double, n: c_uint, margin: c_double, limit: c_uint) -> c_int
+{
+    let res = catch_unwind(|| {
+        let system = unsafe { &mut *(p_system as *mut CompiledSystem) };
+        if n as usize != system.var_table().len()
+        {
+            return -1;
+        }
+        let values = unsafe { slice::from_raw_parts_mut(values, n as usize) };
+
+        // Seed the solver state from the caller's guesses
+        let names: Vec<String> = system.var_table().names().to_vec();
+        for (name, &guess) in names.iter().zip(values.iter())
+        {
+            system.set_guess(name, guess);
+        }
+
+        match system.solve(margin, limit as usize)
+        {
+            Ok(soln) => {
+                for (name, out) in names.iter().zip(values.iter_mut())
+                {
+                    *out = soln[name];
+                }
+                1
+            },
+            Err(_) => -1,
+        }
+    });
+
+    res.unwrap_or(-1)
+}
+
+/// Solves `n_sets` independent input sets against the compiled system at
+/// the given handle in one call, distributing the solves across the
+/// rayon thread pool. `inputs` holds `n_sets * n` doubles of initial
+/// guesses (one contiguous set after another, each in
+/// `compiled_system_var_name` order) and `outputs` receives the same
+/// layout of solutions. Sets that fail to solve have their outputs
+/// filled with NaN.
+///
+/// Returns the number of sets solved successfully, or `-1` on error.
+#[no_mangle]
+pub extern "C" fn solve_compiled_system_batch(p_system: *const c_void, inputs: *const c_double, outputs: *mut c_double, n_sets: c_uint, n: c_uint, margin: c_double, limit: c_uint) -> c_int
+{
+    let res = catch_unwind(|| {
+        let system = unsafe { &*(p_system as *const CompiledSystem) };
+        let n = n as usize;
+        if n != system.var_table().len()
+        {
+            return -1;
+        }
+        let inputs = unsafe { slice::from_raw_parts(inputs, n_sets as usize * n) };
+        let outputs = unsafe { slice::from_raw_parts_mut(outputs, n_sets as usize * n) };
+        let names: Vec<String> = system.var_table().names().to_vec();
+
+        // Each task works on a clone of the compiled system, so the
+        // bytecode is shared read-only and only the small state vector
+        // is duplicated per solve
+        let solved: c_int = inputs.par_chunks_exact(n)
+            .zip(outputs.par_chunks_exact_mut(n))
+            .map(|(input, output)| {
+                let mut task = system.clone();
+                for (name, &guess) in names.iter().zip(input.iter())
+                {
+                    task.set_guess(name, guess);
+                }
+
+                match task.solve(margin, limit as usize)
+                {
+                    Ok(soln) => {
+                        for (name, out) in names.iter().zip(output.iter_mut())
+                        {
+                            *out = soln[name];
+                        }
+                        1
+                    },
+                    Err(_) => {
+                        output.fill(f64::NAN);
+                        0
+                    },
+                }
+            })
+            .sum();
+
+        solved
+    });
+
+    res.unwrap_or(-1)
+}
+
+/// Frees a `CompiledSystem` handle created by `compile_system`
+#[no_mangle]
+pub unsafe extern "C" fn free_compiled_system(p_system: *mut c_void)
+{
+    destroy_object(p_system as *mut CompiledSystem);
+}
@@ -1,7 +1,11 @@
+/// Contains the `CompiledExpr` bytecode form of an expression for fast repeated evaluation.
+pub mod compiled;
 /// Contains functions for checking whether systems or equations are properly constrained for solving.
 pub mod system;
 /// Contains structs for passing information to the shunting yard algorithm. This is re-exported by the `shunting` module.
 mod context;
+/// Contains the `Dual` number type for forward-mode automatic differentiation.
+pub mod dual;
 /// Contains error types for different errors that this crate may throw.
 pub mod errors;
 /// Contains `extern "C"` function definitions for linking this library
@@ -12,6 +16,8 @@ pub mod ffi;
 pub mod newton;
 /// Contains a basic shunting yard algorithm for evaluating strings as mathematical expressions.
 pub mod shunting;
+/// Contains thread-local counters describing the work done by the iterative solvers.
+pub mod telemetry;
 /// Contains the `Variable` type for numbers that exist on a user-specified domain.
 pub mod variable;
 
@@ -20,7 +26,7 @@ use std::collections::{HashMap, HashSet};
 use context::ContextLike;
 use errors::EquationSolverError;
 use newton::newton_raphson;
-use shunting::{ContextHashMap, compile_to_fn, compile_to_fn_of_hashmap, get_legal_variables_iter, new_context};
+use shunting::{ContextHashMap, ParseCache, compile_to_fn, get_legal_variables_iter, new_context};
 use system::get_equation_unknowns;
 
 /// An internal function for formatting a single-unknown equation to an expression prior to tokenization 
@@ -38,8 +44,11 @@ pub (in crate) fn compile_equation_to_fn(equation: &str, ctx: &ContextHashMap) -
     compile_to_fn(&format!("{} - ({})", sides[0], sides[1]), ctx)
 }
 
-/// An internal function for formatting an equation to an expression prior to tokenization 
-pub (in crate) fn compile_equation_to_fn_of_hashmap(equation: &str, ctx: &mut ContextHashMap) -> anyhow::Result<impl Fn(&HashMap<String, f64>) -> anyhow::Result<f64>>
+/// An internal function for formatting an equation to an expression prior
+/// to tokenization. Compiling through a `ParseCache` means the returned
+/// closure shares the cache's context instead of deep-copying it, and
+/// re-compiling an already-seen equation skips the shunting yard
+pub (in crate) fn compile_equation_with_parse_cache(equation: &str, cache: &mut ParseCache) -> anyhow::Result<impl Fn(&HashMap<String, f64>) -> anyhow::Result<f64>>
 {
     // Ensure that we're solving just one equation
     let sides: Vec<&str> = equation.split('=').collect();
@@ -50,18 +59,18 @@ pub (in crate) fn compile_equation_to_fn_of_hashmap(equation: &str, ctx: &mut Co
         _ => return Err(EquationSolverError::FoundMultipleEquations.into()),
     }
 
-    // Get the unknowns. Need to be owned to mutate ctx
-    let unknowns: Vec<String> = get_equation_unknowns(equation, ctx)
+    // Get the unknowns. Need to be owned to mutate the shared context
+    let unknowns: Vec<String> = get_equation_unknowns(equation, cache.context())
         .map(|x| x.to_owned())
         .collect();
 
     // Add a default guess value of 1 for all unspecified vars
     for var in unknowns
     {
-        ctx.add_var_with_domain_to_ctx(&var, 1.0, f64::NEG_INFINITY, f64::INFINITY);
+        cache.add_var_with_domain(&var, 1.0, f64::NEG_INFINITY, f64::INFINITY);
     }
 
-    compile_to_fn_of_hashmap(&format!("{} - ({})", sides[0], sides[1]), ctx)
+    cache.compile_to_fn_of_hashmap(&format!("{} - ({})", sides[0], sides[1]))
 }
 
 /// Solves an equation given as a string for the SINGLE
@@ -1,7 +1,10 @@
 use std::collections::HashMap;
 use std::hash::Hash;
 use gmatlib::Matrix;
+use gmatlib::lu::LuDecomposition;
+use gmatlib::sparse::SparseMatrix;
 use crate::errors::NewtonRaphsonSolverError;
+use crate::telemetry;
 
 const _DX_: f64 = 0.001; 
 
@@ -122,6 +125,7 @@ where
     {
         return Err(NewtonRaphsonSolverError::ImproperlyConstrainedSystem.into());
     }
+    telemetry::count_iteration();
 
     // Build jacobian w/ F(X) values... we will mutate them to F'(X) later
     let mut elements = vec![];
@@ -152,10 +156,14 @@ where
         if let Some(v) = guess.get_mut(var)
         {
             *v -= _DX_;
-        } 
+        }
     }
+    telemetry::count_jacobian_build();
+    telemetry::count_residual_evals(n * (n + 1));
 
-    jacobian.try_inplace_invert()?;
+    // Factor the jacobian once; back-substitution against the factors
+    // is cheaper and more robust than building an explicit inverse.
+    let lu = LuDecomposition::try_from_matrix(jacobian)?;
 
     // Calculate current error
     let mut y = vec![0.0; n];
@@ -166,9 +174,12 @@ where
     let error = y.iter()
         .map(|v| v.powi(2))
         .sum::<f64>();
+    telemetry::count_residual_evals(n);
+    telemetry::record_final_residual(error);
 
     // Calculate change vector and its magnitude
-    let deltas = jacobian * Matrix::from_col_vec(y);
+    let deltas = lu.solve(&Matrix::from_col_vec(y))?;
+    telemetry::count_jacobian_solve();
     let change = deltas.iter()
         .map(|d| d.powi(2))
         .sum::<f64>()
@@ -190,4 +201,528 @@ where
 
     // COMPUTER, ENHANCE!
     multivariate_newton_raphson(f, guess, margin, limit - 1)
-}
\ No newline at end of file
+}
+
+/// A variant of `multivariate_newton_raphson` that stores the jacobian as a
+/// `gmatlib::sparse::SparseMatrix<f64>`, keeping only the structurally
+/// nonzero partial derivatives.
+///
+/// For large nodal systems where each function only touches a handful of
+/// variables, this keeps jacobian memory proportional to the number of
+/// nonzero couplings rather than the square of the system size. The linear
+/// step is solved iteratively with Gauss-Seidel and falls back to a dense
+/// LU factorization when the iteration fails to converge.
+///
+/// # Example
+/// ```
+/// use std::io::Error;
+/// use std::collections::HashMap;
+/// use geqslib::newton::multivariate_newton_raphson_sparse;
+///
+/// fn f1(x: &HashMap<String, f64>) -> Result<f64, Error>
+/// {
+///     Ok(x["x"] + x["y"] - 9.0)
+/// }
+///
+/// fn f2(x: &HashMap<String, f64>) -> Result<f64, Error>
+/// {
+///     Ok(x["x"] - x["y"] - 4.0)
+/// }
+///
+/// let mut guess = HashMap::from([
+///     ("x".to_string(), 7.0),
+///     ("y".to_string(), 2.0),
+/// ]);
+///
+/// let soln = multivariate_newton_raphson_sparse(
+///     vec![f1, f2],
+///     &mut guess,
+///     0.0001,
+///     50,
+/// ).unwrap();
+///
+/// assert!(soln["x"] - 6.5 < 0.0001);
+/// assert!(soln["y"] - 2.5 < 0.0001);
+/// ```
+pub fn multivariate_newton_raphson_sparse<K, E>(f: Vec<impl Fn(&HashMap<K, f64>) -> Result<f64, E>>, guess: &mut HashMap<K, f64>, margin: f64, limit: usize) -> anyhow::Result<&mut HashMap<K, f64>>
+where
+    K: Clone + Eq + Hash,
+    anyhow::Error: From<E>,
+{
+    // Catch illegal margin of error
+    if margin <= 0.0
+    {
+        return Err(NewtonRaphsonSolverError::NegativeMargin.into());
+    }
+
+    // Allow user to manually prevent stack overflow
+    if limit == 0
+    {
+        return Err(NewtonRaphsonSolverError::ReachedIterationLimit.into());
+    }
+
+    // Establish system size and ensure number of functions == number of vars
+    let n = f.len();
+    if guess.len() != n
+    {
+        return Err(NewtonRaphsonSolverError::ImproperlyConstrainedSystem.into());
+    }
+    telemetry::count_iteration();
+
+    // Evaluate the residuals at the current guess
+    let mut y = vec![0.0; n];
+    for i in 0..n
+    {
+        y[i] = f[i](guess)?;
+    }
+    let error = y.iter()
+        .map(|v| v.powi(2))
+        .sum::<f64>();
+    telemetry::count_residual_evals(n);
+    telemetry::record_final_residual(error);
+
+    // Copy keys to iterate over hashmap
+    let vars = Vec::from_iter(
+        guess.keys().map(|x| x.to_owned())
+    );
+
+    // Assemble only the nonzero partial derivatives into triplets
+    let mut triplets = vec![];
+    for (j, var) in vars.iter().enumerate()
+    {
+        if let Some(v) = guess.get_mut(var)
+        {
+            *v += _DX_;
+        }
+        for i in 0..n
+        {
+            let partial = (f[i](guess)? - y[i]) / _DX_;
+            if partial != 0.0
+            {
+                triplets.push((i, j, partial));
+            }
+        }
+        if let Some(v) = guess.get_mut(var)
+        {
+            *v -= _DX_;
+        }
+    }
+    let jacobian = SparseMatrix::from_triplets(n, n, triplets)?;
+    telemetry::count_jacobian_build();
+    telemetry::count_residual_evals(n * n);
+
+    // Calculate change vector, falling back to a dense factorization if
+    // the iterative solve cannot converge for this jacobian
+    let residuals = Matrix::from_col_vec(y);
+    let deltas = match jacobian.try_solve_gauss_seidel(&residuals, margin * 1e-3, 10 * n)
+    {
+        Ok(d) => d,
+        Err(_) => LuDecomposition::try_from_matrix(jacobian.to_dense())?
+            .solve(&residuals)?,
+    };
+    telemetry::count_jacobian_solve();
+    let change = deltas.iter()
+        .map(|d| d.powi(2))
+        .sum::<f64>()
+        .sqrt();
+
+    if error <= margin && change <= margin
+    {
+        return Ok(guess);
+    }
+
+    // Build next guess vector
+    for (i, var) in vars.iter().enumerate().take(n)
+    {
+        if let (Some(guess_val), delta) = (guess.get_mut(var), deltas[(i, 0)])
+        {
+            *guess_val -= delta;
+        }
+    }
+
+    multivariate_newton_raphson_sparse(f, guess, margin, limit - 1)
+}
+
+/// A quasi-Newton variant of `multivariate_newton_raphson` that amortizes
+/// jacobian construction with Broyden rank-1 updates.
+///
+/// # Concept:
+/// Rebuilding the finite-difference jacobian costs n extra evaluations of
+/// every function in the system, and for smooth systems the partials
+/// barely change between iterations. This solver only builds the full
+/// jacobian every `refresh` iterations; in between, it patches the
+/// previous jacobian with the rank-1 Broyden correction implied by the
+/// last step, which costs no function evaluations at all. If a step
+/// fails to shrink the residual or the patched jacobian goes singular,
+/// the stale jacobian is thrown out and rebuilt early. A `refresh` of 1
+/// or 0 degenerates to ordinary Newton-Raphson.
+///
+/// # Example
+/// ```
+/// use std::io::Error;
+/// use std::collections::HashMap;
+/// use geqslib::newton::multivariate_broyden;
+///
+/// fn f1(x: &HashMap<String, f64>) -> Result<f64, Error>
+/// {
+///     Ok(x["x"] + x["y"] - 9.0)
+/// }
+///
+/// fn f2(x: &HashMap<String, f64>) -> Result<f64, Error>
+/// {
+///     Ok(x["x"] - x["y"] - 4.0)
+/// }
+///
+/// let mut guess = HashMap::from([
+///     ("x".to_string(), 7.0),
+///     ("y".to_string(), 2.0),
+/// ]);
+///
+/// let soln = multivariate_broyden(
+///     vec![f1, f2],
+///     &mut guess,
+///     5, // full jacobian rebuild every 5th iteration
+///     0.0001,
+///     50,
+/// ).unwrap();
+///
+/// assert!(soln["x"] - 6.5 < 0.0001);
+/// assert!(soln["y"] - 2.5 < 0.0001);
+/// ```
+pub fn multivariate_broyden<K, E>(f: Vec<impl Fn(&HashMap<K, f64>) -> Result<f64, E>>, guess: &mut HashMap<K, f64>, refresh: usize, margin: f64, limit: usize) -> anyhow::Result<&mut HashMap<K, f64>>
+where
+    K: Clone + Eq + Hash,
+    anyhow::Error: From<E>,
+{
+    // Catch illegal margin of error
+    if margin <= 0.0
+    {
+        return Err(NewtonRaphsonSolverError::NegativeMargin.into());
+    }
+
+    // Establish system size and ensure number of functions == number of vars
+    let n = f.len();
+    if guess.len() != n
+    {
+        return Err(NewtonRaphsonSolverError::ImproperlyConstrainedSystem.into());
+    }
+
+    // Copy keys to iterate over hashmap
+    let vars = Vec::from_iter(
+        guess.keys().map(|x| x.to_owned())
+    );
+
+    // Evaluate the residuals and build the first full jacobian
+    let mut y = vec![0.0; n];
+    for i in 0..n
+    {
+        y[i] = f[i](guess)?;
+    }
+    telemetry::count_residual_evals(n);
+    let mut jacobian = Matrix::new(n, n);
+    fill_fd_jacobian(&f, guess, &vars, &y, &mut jacobian)?;
+    let mut since_refresh = 0;
+
+    for _ in 0..limit
+    {
+        telemetry::count_iteration();
+        let error = y.iter()
+            .map(|v| v.powi(2))
+            .sum::<f64>();
+        telemetry::record_final_residual(error);
+
+        // Solve against a copy so the jacobian survives for updating
+        let mut factors = jacobian.clone();
+        let mut deltas = y.clone();
+        if solve_in_place(&mut factors, &mut deltas).is_err()
+        {
+            // A patched jacobian went singular; rebuild and retry once
+            if since_refresh == 0
+            {
+                return Err(gmatlib::error::SingularMatrixError.into());
+            }
+            fill_fd_jacobian(&f, guess, &vars, &y, &mut jacobian)?;
+            since_refresh = 0;
+            factors = jacobian.clone();
+            deltas.copy_from_slice(&y);
+            solve_in_place(&mut factors, &mut deltas)?;
+        }
+        telemetry::count_jacobian_solve();
+        let change = deltas.iter()
+            .map(|d| d.powi(2))
+            .sum::<f64>()
+            .sqrt();
+
+        if error <= margin && change <= margin
+        {
+            return Ok(guess);
+        }
+
+        // Build next guess vector
+        for (i, var) in vars.iter().enumerate().take(n)
+        {
+            if let Some(guess_val) = guess.get_mut(var)
+            {
+                *guess_val -= deltas[i];
+            }
+        }
+
+        // Re-evaluate the residuals at the new point
+        let mut y_new = vec![0.0; n];
+        for i in 0..n
+        {
+            y_new[i] = f[i](guess)?;
+        }
+        telemetry::count_residual_evals(n);
+        let new_error = y_new.iter()
+            .map(|v| v.powi(2))
+            .sum::<f64>();
+
+        since_refresh += 1;
+        if since_refresh >= refresh || (new_error >= error && since_refresh > 1)
+        {
+            // Scheduled rebuild, or the stale jacobian stagnated
+            fill_fd_jacobian(&f, guess, &vars, &y_new, &mut jacobian)?;
+            since_refresh = 0;
+        }
+        else
+        {
+            // Broyden rank-1 update: correct the jacobian so it maps the
+            // step just taken onto the change in residuals it produced
+            let dx: Vec<f64> = deltas.iter().map(|d| -d).collect();
+            let denom = dx.iter()
+                .map(|d| d.powi(2))
+                .sum::<f64>();
+            if denom != 0.0
+            {
+                for i in 0..n
+                {
+                    let j_dx: f64 = (0..n).map(|j| jacobian[(i, j)] * dx[j]).sum();
+                    let scale = (y_new[i] - y[i] - j_dx) / denom;
+                    for j in 0..n
+                    {
+                        jacobian[(i, j)] += scale * dx[j];
+                    }
+                }
+            }
+        }
+        y = y_new;
+    }
+
+    Err(NewtonRaphsonSolverError::ReachedIterationLimit.into())
+}
+
+/// Fills `jacobian` with finite-difference partials of `f` about the
+/// current guess, given the residuals `y` already evaluated there.
+fn fill_fd_jacobian<K, E>(f: &[impl Fn(&HashMap<K, f64>) -> Result<f64, E>], guess: &mut HashMap<K, f64>, vars: &[K], y: &[f64], jacobian: &mut Matrix<f64>) -> anyhow::Result<()>
+where
+    K: Clone + Eq + Hash,
+    anyhow::Error: From<E>,
+{
+    for (j, var) in vars.iter().enumerate()
+    {
+        if let Some(v) = guess.get_mut(var)
+        {
+            *v += _DX_;
+        }
+        for (i, func) in f.iter().enumerate()
+        {
+            jacobian[(i, j)] = (func(guess)? - y[i]) / _DX_;
+        }
+        if let Some(v) = guess.get_mut(var)
+        {
+            *v -= _DX_;
+        }
+    }
+    telemetry::count_jacobian_build();
+    telemetry::count_residual_evals(f.len() * vars.len());
+
+    Ok(())
+}
+
+/// A preallocated workspace for solving square nonlinear systems with an
+/// iterative Newton-Raphson loop.
+///
+/// # Concept:
+/// The recursive solvers above allocate fresh residual, key, and jacobian
+/// buffers at every recursion level, which hammers the allocator on deep
+/// solves and batch workloads. A `NewtonWorkspace` allocates those
+/// buffers once, runs the iteration as a flat loop, and can be reused
+/// across any number of solves of the same size — functions here take
+/// their state as a plain `&[f64]` rather than a `HashMap`, so there is
+/// no hashing in the inner loop either.
+///
+/// # Example
+/// ```
+/// use std::convert::Infallible;
+/// use geqslib::newton::NewtonWorkspace;
+///
+/// fn f1(x: &[f64]) -> Result<f64, Infallible>
+/// {
+///     Ok(x[0] + x[1] - 9.0)
+/// }
+///
+/// fn f2(x: &[f64]) -> Result<f64, Infallible>
+/// {
+///     Ok(x[0] - x[1] - 4.0)
+/// }
+///
+/// let system: [fn(&[f64]) -> Result<f64, Infallible>; 2] = [f1, f2];
+///
+/// let mut ws = NewtonWorkspace::new(2);
+/// let mut x = [7.0, 2.0];
+///
+/// ws.solve(&system, &mut x, 0.0001, 50).unwrap();
+///
+/// assert!((x[0] - 6.5).abs() < 0.001);
+/// assert!((x[1] - 2.5).abs() < 0.001);
+/// ```
+pub struct NewtonWorkspace
+{
+    n: usize,
+    jacobian: Matrix<f64>,
+    y: Vec<f64>,
+    deltas: Vec<f64>,
+}
+
+impl NewtonWorkspace
+{
+    /// Creates a workspace for systems of `n` functions of `n` variables.
+    pub fn new(n: usize) -> NewtonWorkspace
+    {
+        NewtonWorkspace
+        {
+            n,
+            jacobian: Matrix::new(n, n),
+            y: vec![0.0; n],
+            deltas: vec![0.0; n],
+        }
+    }
+
+    /// Iteratively drives `guess` toward a root of the system using the
+    /// workspace's preallocated buffers. The convergence guarantees and
+    /// `margin`/`limit` semantics match `multivariate_newton_raphson`;
+    /// only the buffers and call shape differ.
+    pub fn solve<E>(&mut self, f: &[impl Fn(&[f64]) -> Result<f64, E>], guess: &mut [f64], margin: f64, limit: usize) -> anyhow::Result<()>
+    where anyhow::Error: From<E>
+    {
+        // Catch illegal margin of error
+        if margin <= 0.0
+        {
+            return Err(NewtonRaphsonSolverError::NegativeMargin.into());
+        }
+
+        // Establish system size and ensure number of functions == number of vars
+        let n = self.n;
+        if f.len() != n || guess.len() != n
+        {
+            return Err(NewtonRaphsonSolverError::ImproperlyConstrainedSystem.into());
+        }
+
+        for _ in 0..limit
+        {
+            telemetry::count_iteration();
+
+            // Evaluate the residuals at the current guess
+            for i in 0..n
+            {
+                self.y[i] = f[i](guess)?;
+            }
+            let error = self.y.iter()
+                .map(|v| v.powi(2))
+                .sum::<f64>();
+            telemetry::count_residual_evals(n);
+            telemetry::record_final_residual(error);
+
+            // Fill the jacobian with finite-difference partials, one
+            // perturbed column at a time
+            for j in 0..n
+            {
+                guess[j] += _DX_;
+                for i in 0..n
+                {
+                    self.jacobian[(i, j)] = (f[i](guess)? - self.y[i]) / _DX_;
+                }
+                guess[j] -= _DX_;
+            }
+            telemetry::count_jacobian_build();
+            telemetry::count_residual_evals(n * n);
+
+            // Calculate change vector and its magnitude
+            self.deltas.copy_from_slice(&self.y);
+            solve_in_place(&mut self.jacobian, &mut self.deltas)?;
+            telemetry::count_jacobian_solve();
+            let change = self.deltas.iter()
+                .map(|d| d.powi(2))
+                .sum::<f64>()
+                .sqrt();
+
+            if error <= margin && change <= margin
+            {
+                return Ok(());
+            }
+
+            // Build next guess vector
+            for i in 0..n
+            {
+                guess[i] -= self.deltas[i];
+            }
+        }
+
+        Err(NewtonRaphsonSolverError::ReachedIterationLimit.into())
+    }
+}
+
+/// Solves the dense square system `a * x = b` by Gaussian elimination
+/// with partial pivoting, overwriting `a` with its eliminated form and
+/// `b` with the solution. Runs entirely in the caller's buffers.
+pub (in crate) fn solve_in_place(a: &mut Matrix<f64>, b: &mut [f64]) -> anyhow::Result<()>
+{
+    let n = b.len();
+
+    for k in 0..n
+    {
+        // Swap the row with the largest magnitude pivot into place
+        let mut pivot = k;
+        for i in (k + 1)..n
+        {
+            if a[(i, k)].abs() > a[(pivot, k)].abs()
+            {
+                pivot = i;
+            }
+        }
+        if a[(pivot, k)] == 0.0
+        {
+            return Err(gmatlib::error::SingularMatrixError.into());
+        }
+        if pivot != k
+        {
+            a.inplace_row_swap(k, pivot);
+            b.swap(k, pivot);
+        }
+
+        // Eliminate the column below the pivot
+        for i in (k + 1)..n
+        {
+            let factor = a[(i, k)] / a[(k, k)];
+            if factor != 0.0
+            {
+                a.inplace_scaled_row_add(i, k, -factor);
+                b[i] -= factor * b[k];
+            }
+        }
+    }
+
+    // Back-substitute through the upper triangle
+    for i in (0..n).rev()
+    {
+        let mut sum = b[i];
+        for j in (i + 1)..n
+        {
+            sum -= a[(i, j)] * b[j];
+        }
+        b[i] = sum / a[(i, i)];
+    }
+
+    Ok(())
+}
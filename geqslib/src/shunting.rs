@@ -1,6 +1,7 @@
 use std::cell::RefCell;
 use std::collections::HashMap;
 use std::rc::Rc;
+use std::sync::Arc;
 use crate::{errors::{ShuntingYardError, ExpressionCompilationError, CompiledExpressionLookupError}, variable::Variable};
 pub use crate::context::*;
 use anyhow;
@@ -122,9 +123,9 @@ fn tokenize_with_context(tok: &str, context: &ContextHashMap) -> anyhow::Result<
     }
 }
 
-/// See shunting yard implementation details at: 
+/// See shunting yard implementation details at:
 /// https://en.wikipedia.org/wiki/Shunting_yard_algorithm
-fn rpnify(expr: &str, context: &ContextHashMap) -> anyhow::Result<Vec<Token>> 
+pub (in crate) fn rpnify(expr: &str, context: &ContextHashMap) -> anyhow::Result<Vec<Token>>
 {
     let punctuated = punctuate(expr);
     let words = punctuated.split(' ').filter(|c| !c.is_empty());
@@ -386,6 +387,134 @@ pub fn compile_to_fn(expr: &str, context: &ContextHashMap) -> anyhow::Result<imp
     }
 }
 
+/// A compilation front-end that shares one immutable context across all
+/// the expressions compiled through it and memoizes their parsed forms.
+///
+/// # Concept:
+/// `compile_to_fn_of_hashmap` clones the entire `ContextHashMap` — every
+/// `String` key and every `Rc` — into each closure it returns, and
+/// callers that probe the same equation string repeatedly pay for the
+/// shunting yard again each time. A `ParseCache` freezes the context
+/// behind an `Arc` so every compiled closure references the SAME map,
+/// and keeps each distinct expression's token stack behind an `Rc` so
+/// `rpnify` runs once per distinct string. Variable VALUES stay mutable
+/// through their `Rc<RefCell<..>>` cells; only the shape of the context
+/// is frozen.
+///
+/// # Example
+/// ```
+/// use std::collections::HashMap;
+/// use geqslib::shunting::{new_context, ContextLike, ParseCache};
+///
+/// let mut ctx = new_context();
+/// ctx.add_var_to_ctx("x", 4);
+/// ctx.add_var_to_ctx("y", 2);
+///
+/// let mut cache = ParseCache::new(ctx);
+///
+/// // Both closures reference one shared context; the second compile of
+/// // the same string reuses the first one's token stack
+/// let f = cache.compile_to_fn_of_hashmap("x + 4 * y").unwrap();
+/// let g = cache.compile_to_fn_of_hashmap("x + 4 * y").unwrap();
+///
+/// let input = HashMap::from([
+///     ("x".to_string(), 8.0),
+///     ("y".to_string(), 0.5),
+/// ]);
+///
+/// assert_eq!(f(&input).unwrap(), 10.0);
+/// assert_eq!(g(&input).unwrap(), 10.0);
+/// ```
+pub struct ParseCache
+{
+    context: Arc<ContextHashMap>,
+    parsed: HashMap<String, Rc<Vec<Token>>>,
+}
+
+impl ParseCache
+{
+    /// Freezes the given context and creates an empty cache over it.
+    pub fn new(context: ContextHashMap) -> ParseCache
+    {
+        ParseCache
+        {
+            context: Arc::new(context),
+            parsed: HashMap::new(),
+        }
+    }
+
+    /// Gives access to the shared context the cache compiles against.
+    pub fn context(&self) -> &Arc<ContextHashMap>
+    {
+        &self.context
+    }
+
+    /// Adds a variable to the shared context, forking the frozen map if
+    /// any previously-compiled closure still references it. Forked-off
+    /// closures keep the view of the context they were compiled against,
+    /// but the variable CELLS are shared between the forks, so value
+    /// updates still reach every closure — the same visibility semantics
+    /// as the deep copies made by the free `compile_to_fn_of_hashmap`,
+    /// at the cost of one map clone per new variable rather than one
+    /// per compiled expression.
+    pub fn add_var_with_domain(&mut self, name: &str, val: f64, min: f64, max: f64)
+    {
+        Arc::make_mut(&mut self.context).add_var_with_domain_to_ctx(name, val, min, max);
+    }
+
+    /// Recovers the context map from the cache, cloning it only if a
+    /// compiled closure still shares it.
+    pub fn into_context(self) -> ContextHashMap
+    {
+        Arc::try_unwrap(self.context).unwrap_or_else(|arc| (*arc).clone())
+    }
+
+    /// Parses an expression to a postfix token stack, reusing the stack
+    /// from an earlier call if this exact string has been seen before.
+    pub fn rpnify(&mut self, expr: &str) -> anyhow::Result<Rc<Vec<Token>>>
+    {
+        if let Some(rpn) = self.parsed.get(expr)
+        {
+            return Ok(Rc::clone(rpn));
+        }
+
+        let rpn = Rc::new(rpnify(expr, &self.context)?);
+        self.parsed.insert(expr.to_owned(), Rc::clone(&rpn));
+        Ok(rpn)
+    }
+
+    /// The `ParseCache` counterpart of the free `compile_to_fn_of_hashmap`
+    /// function. The returned closure holds an `Arc` to the shared
+    /// context rather than a deep copy of it, and its token stack comes
+    /// from the cache.
+    pub fn compile_to_fn_of_hashmap(&mut self, expr: &str) -> anyhow::Result<impl Fn(&HashMap<String, f64>) -> anyhow::Result<f64>>
+    {
+        // Check that all vars are given in context, we reference the Rc's from there
+        for var in get_legal_variables_iter(expr)
+        {
+            if !self.context.contains_key(var)
+            {
+                return Err(ExpressionCompilationError::VarNotFoundInContext.into());
+            }
+        }
+
+        let rpn = self.rpnify(expr)?;
+        let arg_lookup_table = Arc::clone(&self.context);
+
+        Ok(move |x: &HashMap<String, f64>| {
+            for (var, value) in x
+            {
+                match arg_lookup_table.get(var)
+                {
+                    Some(Token::Var(r)) => (*r.borrow_mut()).set(*value),
+                    _ => return Err(CompiledExpressionLookupError.into()),
+                }
+            }
+            eval_rpn_expression(&rpn)
+        })
+    }
+}
+
 /// Evaluates a postfix token stack, returning an f64 value on success.
 fn eval_rpn_expression(expr: &Vec<Token>) -> anyhow::Result<f64> 
 {    
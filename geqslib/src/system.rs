@@ -1,7 +1,24 @@
 use std::collections::{HashMap, HashSet};
-use crate::newton::multivariate_newton_raphson;
-use crate::shunting::{get_legal_variables_iter, ContextHashMap, Token};
-use crate::compile_equation_to_fn_of_hashmap;
+use crate::errors::NewtonRaphsonSolverError;
+use crate::newton::{multivariate_broyden, multivariate_newton_raphson};
+use crate::shunting::{get_legal_variables_iter, ContextHashMap, ContextLike, ParseCache, Token};
+use crate::compile_equation_with_parse_cache;
+
+/// An enum for selecting the root-finding algorithm used by
+/// `System::solve_with`.
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub enum SolverMethod
+{
+    /// Rebuilds the full finite-difference jacobian on every iteration.
+    /// The most robust choice, and the default used by `System::solve`.
+    NewtonRaphson,
+
+    /// Patches the jacobian with Broyden rank-1 updates between full
+    /// rebuilds, which happen every `refresh` iterations or whenever the
+    /// patched jacobian stagnates. Much cheaper per iteration for smooth
+    /// systems with expensive equations.
+    Broyden { refresh: usize },
+}
 
 /// An enum for indicating why an equation could or could not be added
 /// to a system of equations in a `SystemBuilder`.
@@ -24,11 +41,15 @@ pub enum ConstrainResult
 /// Type alias for `System` and `SystemBuilder`
 type BoxedFnOfHashMapToResultF64 = Box<dyn Fn(&HashMap<String, f64>) -> anyhow::Result<f64>>;
 
-/// An object for building up a system of equations and ensuring that it is 
+/// An object for building up a system of equations and ensuring that it is
 /// fully constrained prior to attempting to solve it.
+///
+/// Equations compile through a `ParseCache`, so every equation's closure
+/// shares one context instead of deep-copying it and probing the same
+/// equation string twice only runs the shunting yard once.
 pub struct SystemBuilder
 {
-    context: ContextHashMap,
+    cache: ParseCache,
     system_vars: Vec<String>,
     system_equations: Vec<BoxedFnOfHashMapToResultF64>,
 }
@@ -46,17 +67,18 @@ impl SystemBuilder
     /// let my_sys = SystemBuilder::new("x + y = 4", ctx)
     ///     .expect("failed to build system!");
     /// ```
-    pub fn new(equation: &str, mut ctx: ContextHashMap) -> anyhow::Result<SystemBuilder>
+    pub fn new(equation: &str, ctx: ContextHashMap) -> anyhow::Result<SystemBuilder>
     {
-        let system_vars = get_equation_unknowns(equation, &ctx)
+        let mut cache = ParseCache::new(ctx);
+        let system_vars = get_equation_unknowns(equation, cache.context())
             .map(|x| x.to_owned())
             .collect();
 
-        let starting_eqn = Box::new(compile_equation_to_fn_of_hashmap(equation, &mut ctx)?);
+        let starting_eqn = Box::new(compile_equation_with_parse_cache(equation, &mut cache)?);
 
         Ok(SystemBuilder
         {
-            context: ctx,
+            cache,
             system_vars,
             system_equations: vec![starting_eqn],
         })
@@ -124,20 +146,20 @@ impl SystemBuilder
             return Ok(ConstrainResult::WillOverConstrain);
         }
 
-        let mut unknowns: Vec<String> = get_equation_unknowns(equation, &self.context)
+        let mut unknowns: Vec<String> = get_equation_unknowns(equation, self.cache.context())
             // .filter(|&x| !self.system_vars.contains(&x.to_owned()))
             .map(|x| x.to_owned())
             .collect();
 
-        if unknowns.len() > 1 
+        if unknowns.len() > 1
         {
             // Return early if adding the equation will not gainfully constrain the system
             return Ok(ConstrainResult::WillNotConstrain);
-        }        
+        }
 
-        // Add the equation to the system, updating the context with any newly-added variables
+        // Add the equation to the system, updating the shared context with any newly-added variables
         self.system_equations.push(
-            Box::new(compile_equation_to_fn_of_hashmap(equation, &mut self.context)?) 
+            Box::new(compile_equation_with_parse_cache(equation, &mut self.cache)?)
         );
 
         // Add possible newly-found variable to the system
@@ -232,7 +254,7 @@ impl SystemBuilder
         if self.is_fully_constrained()
         {
             return Some(System {
-                context: self.context,
+                context: self.cache.into_context(),
                 system_vars: self.system_vars,
                 system_equations: self.system_equations,
             });
@@ -335,6 +357,38 @@ impl System
     /// assert!((2.5 - soln["y"]).abs() < 0.001);
     /// ```
     pub fn solve(self, margin: f64, limit: usize) -> anyhow::Result<HashMap<String, f64>>
+    {
+        self.solve_with(SolverMethod::NewtonRaphson, margin, limit)
+    }
+
+    /// Like `solve`, but with an explicit choice of root-finding
+    /// algorithm. `SolverMethod::Broyden` amortizes jacobian construction
+    /// across iterations and is usually the better pick when the system's
+    /// equations are expensive to evaluate.
+    ///
+    /// # Example
+    /// ```
+    /// use geqslib::system::{SolverMethod, System, SystemBuilder};
+    /// use geqslib::shunting::new_context;
+    ///
+    /// let mut ctx = new_context();
+    ///
+    /// let mut builder = SystemBuilder::new("x + y = 9", ctx)
+    ///     .expect("Failed to create a system...");
+    /// builder.try_constrain_with("x - y = 4");
+    ///
+    /// let mut sys = builder
+    ///     .build_system()
+    ///     .expect("Failed to constrain system...");
+    ///
+    /// let soln = sys.solve_with(SolverMethod::Broyden { refresh: 5 }, 0.0001, 50)
+    ///     .expect("Failed to find a solution...");
+    ///
+    /// // Solution is x = 6.5, y = 2.5
+    /// assert!((6.5 - soln["x"]).abs() < 0.001);
+    /// assert!((2.5 - soln["y"]).abs() < 0.001);
+    /// ```
+    pub fn solve_with(self, method: SolverMethod, margin: f64, limit: usize) -> anyhow::Result<HashMap<String, f64>>
     {
         let mut guess = HashMap::new();
         for (key, var) in self.context
@@ -346,12 +400,22 @@ impl System
             };
         }
 
-        let res = multivariate_newton_raphson(
-            self.system_equations, 
-            &mut guess,
-            margin, 
-            limit
-        )?;
+        let res = match method
+        {
+            SolverMethod::NewtonRaphson => multivariate_newton_raphson(
+                self.system_equations,
+                &mut guess,
+                margin,
+                limit
+            )?,
+            SolverMethod::Broyden { refresh } => multivariate_broyden(
+                self.system_equations,
+                &mut guess,
+                refresh,
+                margin,
+                limit
+            )?,
+        };
 
         Ok(res.clone())
     }
@@ -381,3 +445,268 @@ pub fn get_equation_unknowns<'a>(equation: &'a str, ctx: &'a ContextHashMap) ->
         .collect::<HashSet<&str>>()
         .into_iter()
 }
+
+/// Splits a system of equations into minimal sub-systems ordered so that
+/// each block only depends on variables solved by earlier blocks.
+/// Returns the blocks as lists of indices into `equations`.
+///
+/// # Concept:
+/// Real models are rarely one dense knot of equations — they are
+/// block-triangular, with small strongly-coupled clusters feeding one
+/// another in sequence. This pass pairs each equation with one of its
+/// unknowns by maximum bipartite matching, draws a dependency edge from
+/// each equation to the equations owning the other variables it reads,
+/// and extracts the strongly connected components of that graph in
+/// dependency order. Solving the resulting blocks one at a time turns a
+/// single O(n^3) solve into a sequence of much smaller ones.
+///
+/// # Example
+/// ```
+/// use geqslib::system::decompose_into_blocks;
+/// use geqslib::shunting::new_context;
+///
+/// let equations = ["x + y = a + 7", "a = 2", "x - y = a"];
+/// let blocks = decompose_into_blocks(&equations, &new_context()).unwrap();
+///
+/// // "a = 2" must come first; the coupled x/y pair forms one block
+/// assert_eq!(blocks[0], vec![1]);
+/// assert_eq!(blocks[1].len(), 2);
+/// ```
+pub fn decompose_into_blocks(equations: &[&str], ctx: &ContextHashMap) -> anyhow::Result<Vec<Vec<usize>>>
+{
+    let n = equations.len();
+
+    // Collect each equation's unknowns and intern them to indices
+    let mut var_indices: HashMap<String, usize> = HashMap::new();
+    let mut eq_vars: Vec<Vec<usize>> = Vec::with_capacity(n);
+    for equation in equations
+    {
+        let mut vars = vec![];
+        for unknown in get_equation_unknowns(equation, ctx)
+        {
+            let next = var_indices.len();
+            let idx = *var_indices.entry(unknown.to_owned()).or_insert(next);
+            vars.push(idx);
+        }
+        eq_vars.push(vars);
+    }
+    if var_indices.len() != n
+    {
+        return Err(NewtonRaphsonSolverError::ImproperlyConstrainedSystem.into());
+    }
+
+    // Pair each equation with one of its unknowns by augmenting paths
+    let mut var_owner: Vec<Option<usize>> = vec![None; n];
+    for i in 0..n
+    {
+        let mut visited = vec![false; n];
+        if !try_assign(i, &eq_vars, &mut var_owner, &mut visited)
+        {
+            return Err(NewtonRaphsonSolverError::ImproperlyConstrainedSystem.into());
+        }
+    }
+    let mut matched = vec![0usize; n];
+    for (var, owner) in var_owner.iter().enumerate()
+    {
+        if let Some(eq) = owner
+        {
+            matched[*eq] = var;
+        }
+    }
+
+    // Draw a dependency edge from each equation to the owner of every
+    // OTHER variable it reads
+    let mut adj: Vec<Vec<usize>> = vec![vec![]; n];
+    for (i, vars) in eq_vars.iter().enumerate()
+    {
+        for &var in vars
+        {
+            if let Some(j) = var_owner[var]
+            {
+                if j != i
+                {
+                    adj[i].push(j);
+                }
+            }
+        }
+    }
+
+    // Tarjan emits strongly connected components sinks-first, which with
+    // edges pointing at dependencies IS dependency order
+    Ok(tarjan_sccs(&adj))
+}
+
+/// Tries to pair equation `i` with one of its unknowns, reassigning
+/// previously matched equations along an augmenting path if necessary.
+fn try_assign(i: usize, eq_vars: &[Vec<usize>], var_owner: &mut Vec<Option<usize>>, visited: &mut Vec<bool>) -> bool
+{
+    for &var in &eq_vars[i]
+    {
+        if visited[var]
+        {
+            continue;
+        }
+        visited[var] = true;
+
+        let displaced = var_owner[var];
+        if displaced.is_none() || try_assign(displaced.unwrap(), eq_vars, var_owner, visited)
+        {
+            var_owner[var] = Some(i);
+            return true;
+        }
+    }
+    false
+}
+
+/// Returns the strongly connected components of a directed graph in the
+/// order Tarjan's algorithm completes them: components that depend on
+/// nothing come first.
+fn tarjan_sccs(adj: &[Vec<usize>]) -> Vec<Vec<usize>>
+{
+    struct Tarjan<'a>
+    {
+        adj: &'a [Vec<usize>],
+        next_index: usize,
+        index: Vec<Option<usize>>,
+        lowlink: Vec<usize>,
+        stack: Vec<usize>,
+        on_stack: Vec<bool>,
+        sccs: Vec<Vec<usize>>,
+    }
+
+    impl Tarjan<'_>
+    {
+        fn strong_connect(&mut self, v: usize)
+        {
+            self.index[v] = Some(self.next_index);
+            self.lowlink[v] = self.next_index;
+            self.next_index += 1;
+            self.stack.push(v);
+            self.on_stack[v] = true;
+
+            for i in 0..self.adj[v].len()
+            {
+                let w = self.adj[v][i];
+                if self.index[w].is_none()
+                {
+                    self.strong_connect(w);
+                    self.lowlink[v] = self.lowlink[v].min(self.lowlink[w]);
+                }
+                else if self.on_stack[w]
+                {
+                    self.lowlink[v] = self.lowlink[v].min(self.index[w].unwrap());
+                }
+            }
+
+            if Some(self.lowlink[v]) == self.index[v]
+            {
+                let mut scc = vec![];
+                loop
+                {
+                    let w = self.stack.pop().unwrap();
+                    self.on_stack[w] = false;
+                    scc.push(w);
+                    if w == v
+                    {
+                        break;
+                    }
+                }
+                self.sccs.push(scc);
+            }
+        }
+    }
+
+    let n = adj.len();
+    let mut state = Tarjan
+    {
+        adj,
+        next_index: 0,
+        index: vec![None; n],
+        lowlink: vec![0; n],
+        stack: vec![],
+        on_stack: vec![false; n],
+        sccs: vec![],
+    };
+
+    for v in 0..n
+    {
+        if state.index[v].is_none()
+        {
+            state.strong_connect(v);
+        }
+    }
+    state.sccs
+}
+
+/// Decomposes a system of equations into minimal blocks with
+/// `decompose_into_blocks` and solves the blocks in dependency order,
+/// folding each block's solution into the context as constants so later
+/// blocks see them as knowns. Returns the values of all unknowns.
+///
+/// # Example
+/// ```
+/// use geqslib::system::solve_system_by_blocks;
+/// use geqslib::shunting::new_context;
+///
+/// let mut ctx = new_context();
+/// let equations = ["x + y = a + 7", "a = 2", "x - y = a"];
+///
+/// let soln = solve_system_by_blocks(&equations, &mut ctx, 0.0001, 50).unwrap();
+///
+/// assert!((soln["a"] - 2.0).abs() < 0.001);
+/// assert!((soln["x"] - 5.5).abs() < 0.001);
+/// assert!((soln["y"] - 3.5).abs() < 0.001);
+/// ```
+pub fn solve_system_by_blocks(equations: &[&str], ctx: &mut ContextHashMap, margin: f64, limit: usize) -> anyhow::Result<HashMap<String, f64>>
+{
+    let blocks = decompose_into_blocks(equations, ctx)?;
+    let mut soln = HashMap::new();
+
+    for block in blocks
+    {
+        // Register every unknown in the block BEFORE compiling any of
+        // its equations: a compiled closure checks the solver's guesses
+        // against the context it was compiled with, so a variable that
+        // first appears in a later equation must already be present when
+        // the earlier ones compile. The block's order within the deck
+        // carries no chaining guarantee either way.
+        let mut block_vars: Vec<String> = vec![];
+        for &i in &block
+        {
+            for unknown in get_equation_unknowns(equations[i], ctx)
+            {
+                if !block_vars.iter().any(|v| v == unknown)
+                {
+                    block_vars.push(unknown.to_owned());
+                }
+            }
+        }
+
+        let mut cache = ParseCache::new(ctx.clone());
+        for var in &block_vars
+        {
+            cache.add_var_with_domain(var, 1.0, f64::NEG_INFINITY, f64::INFINITY);
+        }
+
+        // Each block is a minimal fully-constrained system given the
+        // values folded in by the blocks before it
+        let mut block_eqns = Vec::with_capacity(block.len());
+        for &i in &block
+        {
+            block_eqns.push(compile_equation_with_parse_cache(equations[i], &mut cache)?);
+        }
+
+        let mut guess: HashMap<String, f64> = block_vars.iter()
+            .map(|var| (var.to_owned(), 1.0))
+            .collect();
+        multivariate_newton_raphson(block_eqns, &mut guess, margin, limit)?;
+
+        for (var, value) in guess
+        {
+            ctx.add_const_to_ctx(&var, value);
+            soln.insert(var, value);
+        }
+    }
+
+    Ok(soln)
+}
@@ -0,0 +1,136 @@
+//! Counters describing the work done by the iterative solvers.
+//!
+//! # Concept:
+//! When a solve is slow, the first question is always "slow doing what?" —
+//! iterating, evaluating residuals, or rebuilding and factoring jacobians.
+//! Timing alone cannot distinguish these. This module keeps a handful of
+//! thread-local counters that the solvers in the `newton` module (and
+//! downstream solvers built on this crate) bump as they work, so a caller
+//! can reset them before a solve and read back exactly what it cost:
+//!
+//! ```
+//! use std::io::Error;
+//! use std::collections::HashMap;
+//! use geqslib::newton::multivariate_newton_raphson;
+//! use geqslib::telemetry::{reset_solver_telemetry, solver_telemetry};
+//!
+//! fn f1(x: &HashMap<String, f64>) -> Result<f64, Error>
+//! {
+//!     Ok(x["x"] + x["y"] - 9.0)
+//! }
+//!
+//! fn f2(x: &HashMap<String, f64>) -> Result<f64, Error>
+//! {
+//!     Ok(x["x"] - x["y"] - 4.0)
+//! }
+//!
+//! let mut guess = HashMap::from([
+//!     ("x".to_string(), 7.0),
+//!     ("y".to_string(), 2.0),
+//! ]);
+//!
+//! reset_solver_telemetry();
+//! multivariate_newton_raphson(vec![f1, f2], &mut guess, 0.0001, 50).unwrap();
+//!
+//! let stats = solver_telemetry();
+//! assert!(stats.iterations >= 1);
+//! assert!(stats.jacobian_builds >= 1);
+//! assert!(stats.final_residual < 0.0001);
+//! ```
+//!
+//! The counters are plain thread-local `Cell`s: bumping one is a load and
+//! a store with no locking, so instrumented solvers cost the same as
+//! uninstrumented ones for any system worth measuring.
+
+use std::cell::Cell;
+
+/// A snapshot of the work performed by the solvers on the calling thread
+/// since the counters were last reset.
+#[derive(Debug, Default, Clone, Copy, PartialEq)]
+pub struct SolverTelemetry
+{
+    /// Newton (or quasi-Newton) iterations taken.
+    pub iterations: usize,
+    /// Individual residual function evaluations, including the extra
+    /// evaluations spent on finite-difference partials.
+    pub residual_evals: usize,
+    /// Full jacobian assemblies.
+    pub jacobian_builds: usize,
+    /// Linear solves against a jacobian, whether by factorization or by
+    /// iteration.
+    pub jacobian_solves: usize,
+    /// Sum of squared residuals at the last point a solver evaluated.
+    pub final_residual: f64,
+}
+
+thread_local!
+{
+    static TELEMETRY: Cell<SolverTelemetry> = Cell::new(SolverTelemetry::default());
+}
+
+/// Zeroes the solver telemetry counters for the calling thread.
+pub fn reset_solver_telemetry()
+{
+    TELEMETRY.with(|t| t.set(SolverTelemetry::default()));
+}
+
+/// Returns a snapshot of the solver telemetry counters for the calling
+/// thread. The counters keep accumulating; pair this with
+/// `reset_solver_telemetry` to measure a single solve.
+pub fn solver_telemetry() -> SolverTelemetry
+{
+    TELEMETRY.with(|t| t.get())
+}
+
+/// Records one solver iteration. Intended for solver implementations,
+/// including those in downstream crates.
+pub fn count_iteration()
+{
+    TELEMETRY.with(|t| {
+        let mut stats = t.get();
+        stats.iterations += 1;
+        t.set(stats);
+    });
+}
+
+/// Records `n` residual function evaluations.
+pub fn count_residual_evals(n: usize)
+{
+    TELEMETRY.with(|t| {
+        let mut stats = t.get();
+        stats.residual_evals += n;
+        t.set(stats);
+    });
+}
+
+/// Records one full jacobian assembly.
+pub fn count_jacobian_build()
+{
+    TELEMETRY.with(|t| {
+        let mut stats = t.get();
+        stats.jacobian_builds += 1;
+        t.set(stats);
+    });
+}
+
+/// Records one linear solve against a jacobian.
+pub fn count_jacobian_solve()
+{
+    TELEMETRY.with(|t| {
+        let mut stats = t.get();
+        stats.jacobian_solves += 1;
+        t.set(stats);
+    });
+}
+
+/// Records the sum of squared residuals at the point a solver just
+/// evaluated. Solvers call this every iteration; the last call before
+/// the snapshot is the residual the solve finished with.
+pub fn record_final_residual(sum_of_squares: f64)
+{
+    TELEMETRY.with(|t| {
+        let mut stats = t.get();
+        stats.final_residual = sum_of_squares;
+        t.set(stats);
+    });
+}
@@ -42,4 +42,313 @@ fn ensure_that_single_unknown_solver_can_solve_equation_with_if_statement()
 
     assert_eq!(soln.0, "i".to_owned());
     assert!(soln.1 - 1.0 < 0.001);
-}
\ No newline at end of file
+}
+#[test]
+fn ensure_compiled_expr_matches_token_stack_evaluator()
+{
+    use geqslib::compiled::CompiledExpr;
+
+    let mut ctx = new_context();
+    ctx.add_var_to_ctx("x", 1.5);
+    ctx.add_var_to_ctx("y", -2.0);
+
+    let text = "sin(x) + x ^ 2 - 4 * y / (1 + x)";
+    let expr = CompiledExpr::compile(text, &ctx).unwrap();
+
+    // Feed the same values through both evaluators
+    let mut slots = vec![0.0; expr.num_slots()];
+    slots[expr.slot_of("x").unwrap()] = 1.5;
+    slots[expr.slot_of("y").unwrap()] = -2.0;
+
+    let check = eval_str_with_context(text, &ctx).unwrap();
+    assert!((expr.eval(&slots).unwrap() - check).abs() < 1e-12);
+
+    // Division by zero is still reported as an error
+    let bad = CompiledExpr::compile("x / y", &ctx).unwrap();
+    assert!(bad.eval(&[1.0, 0.0]).is_err());
+}
+
+#[test]
+fn ensure_dual_evaluation_produces_exact_derivatives()
+{
+    use geqslib::compiled::CompiledExpr;
+
+    let mut ctx = new_context();
+    ctx.add_var_to_ctx("x", 0.0);
+    ctx.add_var_to_ctx("y", 0.0);
+
+    let expr = CompiledExpr::compile("y * x ^ 2 + x / y", &ctx).unwrap();
+
+    let x = 1.2;
+    let y = 3.4;
+    let mut slots = vec![0.0; expr.num_slots()];
+    slots[expr.slot_of("x").unwrap()] = x;
+    slots[expr.slot_of("y").unwrap()] = y;
+
+    let mut grad = vec![0.0; expr.num_slots()];
+    let val = expr.eval_grad(&slots, &mut grad).unwrap();
+
+    // Compare against hand-derived partials, not finite differences
+    let check_val = y * x * x + x / y;
+    let check_dx = 2.0 * x * y + 1.0 / y;
+    let check_dy = x * x - x / (y * y);
+
+    assert!((val - check_val).abs() < 1e-12);
+    assert!((grad[expr.slot_of("x").unwrap()] - check_dx).abs() < 1e-12);
+    assert!((grad[expr.slot_of("y").unwrap()] - check_dy).abs() < 1e-12);
+
+    // Built-in functions use their analytic rules, so even a coarse
+    // finite difference could not match this tightly
+    let sine = CompiledExpr::compile("sin(x)", &ctx).unwrap();
+    let d = sine.eval_dual(&[x], 0).unwrap();
+    assert!((d.val - x.sin()).abs() < 1e-15);
+    assert!((d.dot - x.cos()).abs() < 1e-15);
+
+    // A constant expression has no partials but still reports its value
+    let constant = CompiledExpr::compile("2 + 3", &ctx).unwrap();
+    assert_eq!(constant.eval_grad(&[], &mut []).unwrap(), 5.0);
+}
+
+#[test]
+fn ensure_newton_workspace_is_reusable_across_solves()
+{
+    use std::convert::Infallible;
+    use geqslib::newton::NewtonWorkspace;
+
+    // A mildly nonlinear system...
+    fn f1(x: &[f64]) -> Result<f64, Infallible>
+    {
+        Ok(x[0] * x[0] + x[1] - 11.0)
+    }
+    fn f2(x: &[f64]) -> Result<f64, Infallible>
+    {
+        Ok(x[0] + x[1] * x[1] - 7.0)
+    }
+    let system: [fn(&[f64]) -> Result<f64, Infallible>; 2] = [f1, f2];
+
+    let mut ws = NewtonWorkspace::new(2);
+
+    // ...solved repeatedly from different starting points with one workspace
+    for guess in [[1.0, 1.0], [2.5, 3.5], [4.0, 1.0]]
+    {
+        let mut x = guess;
+        ws.solve(&system, &mut x, 1e-8, 100).unwrap();
+
+        assert!((x[0] * x[0] + x[1] - 11.0).abs() < 1e-6);
+        assert!((x[0] + x[1] * x[1] - 7.0).abs() < 1e-6);
+    }
+
+    // Size mismatches are rejected up front
+    let mut wrong = [0.0; 3];
+    assert!(ws.solve(&system, &mut wrong, 1e-8, 100).is_err());
+}
+
+#[test]
+fn ensure_compiled_system_solves_with_dense_state()
+{
+    use geqslib::compiled::CompiledSystem;
+
+    let ctx = new_context();
+
+    // The same nonlinear pair used for the workspace test, expressed as equations
+    let mut sys = CompiledSystem::compile(
+        &["x ^ 2 + y = 11", "x + y ^ 2 = 7"],
+        &ctx
+    ).unwrap();
+
+    sys.set_guess("x", 2.0);
+    sys.set_guess("y", 3.0);
+
+    let soln = sys.solve(0.0001, 100).unwrap();
+    let x = soln["x"];
+    let y = soln["y"];
+
+    assert!((x * x + y - 11.0).abs() < 0.001);
+    assert!((x + y * y - 7.0).abs() < 0.001);
+
+    // An underconstrained system is rejected rather than solved
+    let mut bad = CompiledSystem::compile(&["x + y + z = 1"], &ctx).unwrap();
+    assert!(bad.solve(0.0001, 100).is_err());
+}
+
+#[test]
+fn ensure_parallel_solve_agrees_with_serial_solve()
+{
+    use geqslib::compiled::CompiledSystem;
+
+    let ctx = new_context();
+    let equations = ["x ^ 2 + y = 11", "x + y ^ 2 = 7", "x + y + z = 10"];
+
+    let mut serial = CompiledSystem::compile(&equations, &ctx).unwrap();
+    let mut parallel = CompiledSystem::compile(&equations, &ctx).unwrap();
+
+    for sys in [&mut serial, &mut parallel]
+    {
+        sys.set_guess("x", 2.0);
+        sys.set_guess("y", 3.0);
+    }
+
+    let expected = serial.solve(0.0001, 100).unwrap();
+    let soln = parallel.solve_parallel(0.0001, 100).unwrap();
+
+    for (var, val) in &expected
+    {
+        assert!((soln[var] - val).abs() < 0.001);
+    }
+}
+
+#[test]
+fn ensure_broyden_mode_solves_systems_through_system_solve()
+{
+    use geqslib::system::{SolverMethod, SystemBuilder};
+
+    let ctx = new_context();
+
+    let mut builder = SystemBuilder::new("x ^ 2 + y = 11", ctx).unwrap();
+    builder.try_constrain_with("x + y ^ 2 = 7").unwrap();
+
+    let mut sys = builder.build_system().unwrap();
+    sys.specify_variable("x", 2.0, f64::NEG_INFINITY, f64::INFINITY);
+    sys.specify_variable("y", 3.0, f64::NEG_INFINITY, f64::INFINITY);
+
+    let soln = sys.solve_with(SolverMethod::Broyden { refresh: 5 }, 0.0001, 100).unwrap();
+
+    assert!((soln["x"] * soln["x"] + soln["y"] - 11.0).abs() < 0.001);
+    assert!((soln["x"] + soln["y"] * soln["y"] - 7.0).abs() < 0.001);
+}
+
+#[test]
+fn ensure_block_decomposition_solves_block_triangular_decks()
+{
+    use geqslib::system::{decompose_into_blocks, solve_system_by_blocks};
+
+    let mut ctx = new_context();
+    let equations = [
+        "p + q = m",      // coupled pair, needs m
+        "m = n + 4",      // needs n
+        "n ^ 2 = 9",      // stands alone
+        "p - q = 2",      // coupled pair
+    ];
+
+    // The lone equation leads; the coupled p/q pair trails its inputs
+    let blocks = decompose_into_blocks(&equations, &ctx).unwrap();
+    assert_eq!(blocks.len(), 3);
+    assert_eq!(blocks[0], vec![2]);
+    assert_eq!(blocks[1], vec![1]);
+    assert_eq!(blocks[2].len(), 2);
+
+    let soln = solve_system_by_blocks(&equations, &mut ctx, 0.0001, 100).unwrap();
+    assert!((soln["n"] - 3.0).abs() < 0.001);
+    assert!((soln["m"] - 7.0).abs() < 0.001);
+    assert!((soln["p"] - 4.5).abs() < 0.001);
+    assert!((soln["q"] - 2.5).abs() < 0.001);
+
+    // A deck with more unknowns than equations is rejected up front
+    assert!(decompose_into_blocks(&["x + y = 1"], &new_context()).is_err());
+}
+
+#[test]
+fn ensure_coupled_blocks_solve_regardless_of_equation_order()
+{
+    use geqslib::system::solve_system_by_blocks;
+
+    // A single 3x3 block where the later equations introduce new
+    // unknowns: every equation must see the whole block's variables
+    let equations = ["x + y + z = 6", "x - y = 1", "x - z = 0"];
+    let soln = solve_system_by_blocks(&equations, &mut new_context(), 0.0001, 100).unwrap();
+    assert!((soln["x"] - 7.0 / 3.0).abs() < 0.001);
+    assert!((soln["y"] - 4.0 / 3.0).abs() < 0.001);
+    assert!((soln["z"] - 7.0 / 3.0).abs() < 0.001);
+
+    // A 5x5 strongly connected block (solution is all ones) must solve
+    // no matter how its equations are ordered in the deck
+    let coupled = ["a + u1 = 2", "u1 + u2 = 2", "u2 + v = 2", "v + u1 + u2 + w = 4", "w + a = 2"];
+    let mut deck: Vec<&str> = coupled.to_vec();
+    for rotation in 0..deck.len()
+    {
+        let soln = solve_system_by_blocks(&deck, &mut new_context(), 0.0001, 100)
+            .unwrap_or_else(|_| panic!("failed to solve rotation {}", rotation));
+        for var in ["a", "u1", "u2", "v", "w"]
+        {
+            assert!((soln[var] - 1.0).abs() < 0.001);
+        }
+        deck.rotate_left(1);
+    }
+}
+
+#[test]
+fn ensure_parse_cache_shares_tokens_and_context()
+{
+    use std::rc::Rc;
+    use geqslib::shunting::ParseCache;
+
+    let mut ctx = new_context();
+    ctx.add_var_to_ctx("x", 1.0);
+    ctx.add_var_to_ctx("y", 1.0);
+
+    let mut cache = ParseCache::new(ctx);
+
+    // The second parse of the same string is a cache hit, not a reparse
+    let first = cache.rpnify("x ^ 2 + 4 * y").unwrap();
+    let second = cache.rpnify("x ^ 2 + 4 * y").unwrap();
+    assert!(Rc::ptr_eq(&first, &second));
+
+    // Compiled closures agree with the uncached compiler
+    let f = cache.compile_to_fn_of_hashmap("x ^ 2 + 4 * y").unwrap();
+    let input = HashMap::from([
+        ("x".to_string(), 3.0),
+        ("y".to_string(), 0.25),
+    ]);
+    assert_eq!(f(&input).unwrap(), 10.0);
+
+    // Unknown variables are still rejected at compile time
+    assert!(cache.compile_to_fn_of_hashmap("x + zz").is_err());
+}
+
+#[test]
+fn ensure_compiled_system_ffi_handles_are_reusable()
+{
+    use std::ffi::{c_char, c_void, CString};
+    use geqslib::ffi::{
+        compile_system, compiled_system_var_count, free_compiled_system,
+        free_context_hash_map, new_default_context_hash_map,
+        solve_compiled_system, solve_compiled_system_batch,
+    };
+
+    unsafe
+    {
+        let ctx = new_default_context_hash_map();
+        let equations = [
+            CString::new("x + y = 9").unwrap(),
+            CString::new("x - y = 4").unwrap(),
+        ];
+        let ptrs: Vec<*const c_char> = equations.iter().map(|s| s.as_ptr()).collect();
+
+        let handle = compile_system(ptrs.as_ptr(), 2, ctx);
+        assert!(!handle.is_null());
+        assert_eq!(compiled_system_var_count(handle), 2);
+
+        // One compile, many solves
+        for _ in 0..3
+        {
+            let mut values = [1.0_f64, 1.0];
+            let status = solve_compiled_system(handle as *mut c_void, values.as_mut_ptr(), 2, 0.0001, 50);
+            assert_eq!(status, 1);
+            assert!((values[0] + values[1] - 9.0).abs() < 0.01);
+            assert!((values[0] - values[1] - 4.0).abs() < 0.01);
+        }
+
+        // Three input sets solved in one batched call
+        let inputs = [1.0_f64, 1.0, 2.0, 2.0, 3.0, 3.0];
+        let mut outputs = [0.0_f64; 6];
+        let solved = solve_compiled_system_batch(handle, inputs.as_ptr(), outputs.as_mut_ptr(), 3, 2, 0.0001, 50);
+        assert_eq!(solved, 3);
+        for set in outputs.chunks(2)
+        {
+            assert!((set[0] + set[1] - 9.0).abs() < 0.01);
+        }
+
+        free_compiled_system(handle as *mut c_void);
+        free_context_hash_map(ctx);
+    }
+}
@@ -0,0 +1,144 @@
+//! Criterion micro-benchmarks for the hot `Matrix<f64>` kernels.
+//!
+//! These exist to give the SIMD, blocking, and storage work a stable
+//! baseline and to catch regressions before a release ships. Run with
+//! `cargo bench -p gmatlib`; multiplication and inversion report
+//! throughput in FLOP/s alongside wall time.
+
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use gmatlib::Matrix;
+use rand::rngs::StdRng;
+use rand::{Rng, SeedableRng};
+
+/// The square matrix sizes every sized benchmark sweeps over, spanning
+/// the tiny nodal-solver cases up to cache-unfriendly dense systems.
+const _SIZES_: [usize; 6] = [2, 3, 4, 16, 64, 256];
+
+/// Builds an invertible, well-conditioned n x n test matrix from a
+/// fixed seed so runs are comparable across machines and commits.
+fn test_matrix(n: usize, seed: u64) -> Matrix<f64>
+{
+    let mut rng = StdRng::seed_from_u64(seed);
+    let mut a = Matrix::from_vec(
+        n,
+        (0..n * n).map(|_| rng.gen_range(-1.0..1.0)).collect()
+    ).unwrap();
+
+    // Diagonal dominance keeps inversion away from tiny pivots
+    for i in 0..n
+    {
+        a[(i, i)] += n as f64;
+    }
+    a
+}
+
+fn bench_multiply_matrix(c: &mut Criterion)
+{
+    let mut group = c.benchmark_group("multiply_matrix");
+    for n in _SIZES_
+    {
+        // 2n^3 floating point operations per n x n product
+        group.throughput(Throughput::Elements((2 * n * n * n) as u64));
+        let a = test_matrix(n, 1);
+        let b = test_matrix(n, 2);
+        group.bench_with_input(BenchmarkId::from_parameter(n), &n, |bencher, _| {
+            bencher.iter(|| black_box(&a).multiply_matrix(black_box(&b)).unwrap());
+        });
+    }
+    group.finish();
+}
+
+fn bench_try_inplace_invert(c: &mut Criterion)
+{
+    let mut group = c.benchmark_group("try_inplace_invert");
+    for n in _SIZES_
+    {
+        // Gauss-Jordan inversion costs roughly 2n^3 floating point operations
+        group.throughput(Throughput::Elements((2 * n * n * n) as u64));
+        let a = test_matrix(n, 3);
+        group.bench_with_input(BenchmarkId::from_parameter(n), &n, |bencher, _| {
+            bencher.iter(|| {
+                let mut b = a.clone();
+                b.try_inplace_invert().unwrap();
+                black_box(b)
+            });
+        });
+    }
+    group.finish();
+}
+
+fn bench_inplace_scaled_row_add(c: &mut Criterion)
+{
+    let mut group = c.benchmark_group("inplace_scaled_row_add");
+    for n in _SIZES_
+    {
+        // One multiply and one add per column
+        group.throughput(Throughput::Elements((2 * n) as u64));
+        let a = test_matrix(n, 4);
+        group.bench_with_input(BenchmarkId::from_parameter(n), &n, |bencher, _| {
+            bencher.iter(|| {
+                let mut b = a.clone();
+                b.inplace_scaled_row_add(0, n - 1, black_box(2.5));
+                black_box(b)
+            });
+        });
+    }
+    group.finish();
+}
+
+fn bench_transpose(c: &mut Criterion)
+{
+    let mut group = c.benchmark_group("transpose");
+    for n in _SIZES_
+    {
+        let a = test_matrix(n, 5);
+        group.bench_with_input(BenchmarkId::from_parameter(n), &n, |bencher, _| {
+            bencher.iter(|| black_box(&a).transpose());
+        });
+    }
+    group.finish();
+}
+
+fn bench_indexing(c: &mut Criterion)
+{
+    let n = 64;
+    let a = test_matrix(n, 6);
+
+    c.bench_function("index_read_64x64", |bencher| {
+        bencher.iter(|| {
+            let mut acc = 0.0;
+            for i in 0..n
+            {
+                for j in 0..n
+                {
+                    acc += black_box(&a)[(i, j)];
+                }
+            }
+            black_box(acc)
+        });
+    });
+
+    c.bench_function("index_write_64x64", |bencher| {
+        let mut b = a.clone();
+        bencher.iter(|| {
+            for i in 0..n
+            {
+                for j in 0..n
+                {
+                    b[(i, j)] = black_box(1.5);
+                }
+            }
+            black_box(&mut b);
+        });
+    });
+}
+
+criterion_group!(
+    benches,
+    bench_multiply_matrix,
+    bench_try_inplace_invert,
+    bench_inplace_scaled_row_add,
+    bench_transpose,
+    bench_indexing
+);
+criterion_main!(benches);
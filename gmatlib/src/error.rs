@@ -62,6 +62,17 @@ impl Display for NonSquareMatrixError
 }
 impl Error for NonSquareMatrixError {}
 
+#[derive(Debug)]
+pub struct SingularMatrixError;
+impl Display for SingularMatrixError
+{
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result
+    {
+        write!(f, "could not factor matrix because it is singular to working precision.")
+    }
+}
+impl Error for SingularMatrixError {}
+
 #[derive(Debug)]
 pub struct MatrixFromVecError;
 impl Display for MatrixFromVecError
@@ -72,6 +83,45 @@ impl Display for MatrixFromVecError
 }
 impl Error for MatrixFromVecError {}
 
+#[derive(Debug)]
+pub struct SparseMatrixFromTripletsError
+{
+    pub rows: usize,
+    pub cols: usize,
+    pub i: usize,
+    pub j: usize,
+}
+impl Display for SparseMatrixFromTripletsError
+{
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result
+    {
+        write!(
+            f, "failed to construct SparseMatrix<T> because triplet ({}, {}) is out of bounds for a {} x {} matrix.",
+            self.i, self.j, self.rows, self.cols
+        )
+    }
+}
+impl Error for SparseMatrixFromTripletsError {}
+
+#[derive(Debug)]
+pub enum SparseSolveError
+{
+    MissingDiagonal,
+    DidNotConverge,
+}
+impl Display for SparseSolveError
+{
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result
+    {
+        match self
+        {
+            SparseSolveError::MissingDiagonal => write!(f, "found a structurally zero diagonal entry while iteratively solving sparse system."),
+            SparseSolveError::DidNotConverge  => write!(f, "reached the sweep limit without converging while iteratively solving sparse system."),
+        }
+    }
+}
+impl Error for SparseSolveError {}
+
 #[derive(Debug)]
 pub struct MatrixMultiplicationError;
 impl Display for MatrixMultiplicationError
@@ -80,4 +130,13 @@ impl Display for MatrixMultiplicationError
         write!(f, "failed to multiply matrices because columns of left operand and rows of right operand were not equal.")
     }
 }
-impl Error for MatrixMultiplicationError {}
\ No newline at end of file
+impl Error for MatrixMultiplicationError {}
+#[derive(Debug)]
+pub struct MatrixShapeMismatchError;
+impl Display for MatrixShapeMismatchError
+{
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        write!(f, "failed to perform element-wise operation because operand shapes were not equal.")
+    }
+}
+impl Error for MatrixShapeMismatchError {}
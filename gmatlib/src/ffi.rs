@@ -1,7 +1,8 @@
 use std::ffi::{c_double, c_uint, c_void};
 use std::mem;
 use std::panic::catch_unwind;
-use std::ptr::null_mut;
+use std::ptr::{null_mut, slice_from_raw_parts_mut};
+use std::slice;
 use crate::Matrix;
 
 #[no_mangle]
@@ -321,3 +322,171 @@ pub extern "C" fn free_double_matrix(ptr: *mut c_void)
         let _drop_this = unsafe { Box::from_raw(ptr as *mut Matrix<c_double>) };
     });
 }
+
+/// Allocates a zeroed buffer of `len` doubles that the caller may fill
+/// directly and later hand back to `new_double_matrix_from_buffer`.
+/// Ownership contract: the buffer belongs to the caller until it is
+/// either passed to `new_double_matrix_from_buffer` or released with
+/// `free_double_buffer`; it must never be freed by any other means.
+#[no_mangle]
+pub extern "C" fn alloc_double_buffer(len: c_uint) -> *mut c_double
+{
+    let res = catch_unwind(|| {
+        // A boxed slice guarantees capacity == len, which lets the
+        // buffer be reconstituted without copying later.
+        let buf = vec![0.0 as c_double; len as usize].into_boxed_slice();
+        Box::into_raw(buf) as *mut c_double
+    });
+
+    match res
+    {
+        Ok(ptr) => ptr,
+        Err(_)  => null_mut(),
+    }
+}
+
+/// Releases a buffer obtained from `alloc_double_buffer` that was NOT
+/// consumed by `new_double_matrix_from_buffer`. `len` must be the same
+/// value the buffer was allocated with.
+#[no_mangle]
+pub extern "C" fn free_double_buffer(ptr: *mut c_double, len: c_uint)
+{
+    let _ = catch_unwind(|| {
+        let _drop_this = unsafe {
+            Box::from_raw(slice_from_raw_parts_mut(ptr, len as usize))
+        };
+    });
+}
+
+/// Constructs a `Matrix<f64>` handle directly over a buffer obtained
+/// from `alloc_double_buffer` without copying its elements (matrices
+/// small enough for inline storage are copied to the stack instead,
+/// which is cheaper still). The buffer must hold exactly
+/// `rows * cols` doubles in row-major order.
+/// Ownership contract: on success the buffer is consumed and the caller
+/// must not touch or free it again; on a NULL return the caller still
+/// owns the buffer.
+#[no_mangle]
+pub extern "C" fn new_double_matrix_from_buffer(rows: c_uint, cols: c_uint, buf: *mut c_double) -> *mut c_void
+{
+    let res = catch_unwind(|| {
+        // Validate the shape BEFORE reconstituting the buffer: once the
+        // Box exists, any early return or panic would drop it and free
+        // memory the NULL-return contract says the caller still owns.
+        if buf.is_null() || rows == 0 || cols == 0
+        {
+            return null_mut(); // indicate failure via NULL
+        }
+        let len = rows as usize * cols as usize;
+        let vec = unsafe {
+            Box::from_raw(slice_from_raw_parts_mut(buf, len))
+        }.into_vec();
+
+        // `len` is an exact multiple of `cols`, so this cannot fail
+        let a = Box::new(
+            Matrix::from_vec(cols as usize, vec).expect("buffer length is rows * cols")
+        );
+
+        Box::into_raw(a) as *mut c_void
+    });
+
+    match res
+    {
+        Ok(ptr) => ptr,
+        Err(_)  => null_mut(),
+    }
+}
+
+/// Inverts `n` matrix handles in a single FFI call. Stops at the first
+/// matrix that cannot be inverted and returns the number of matrices
+/// successfully inverted, so a return value of `n` means all succeeded.
+#[no_mangle]
+pub extern "C" fn batch_try_inplace_invert(ptrs: *const *mut c_void, n: c_uint) -> c_uint
+{
+    let res = catch_unwind(|| {
+        let handles = unsafe { slice::from_raw_parts(ptrs, n as usize) };
+        let mut done = 0;
+
+        for &ptr in handles
+        {
+            let mut a = unsafe { Box::from_raw(ptr as *mut Matrix<c_double>) };
+            let status = a.try_inplace_invert();
+            mem::forget(a); // Prevent drop that would deallocate the matrix data
+
+            if status.is_err()
+            {
+                break;
+            }
+            done += 1;
+        }
+
+        done
+    });
+
+    res.unwrap_or(0)
+}
+
+/// Applies the same scaled row addition to `n` matrix handles in a
+/// single FFI call. Returns the number of matrices successfully
+/// updated, so a return value of `n` means all succeeded.
+#[no_mangle]
+pub extern "C" fn batch_inplace_scaled_row_add(ptrs: *const *mut c_void, n: c_uint, r1: c_uint, r2: c_uint, scalar: c_double) -> c_uint
+{
+    let res = catch_unwind(|| {
+        let handles = unsafe { slice::from_raw_parts(ptrs, n as usize) };
+
+        for &ptr in handles
+        {
+            let mut a = unsafe { Box::from_raw(ptr as *mut Matrix<c_double>) };
+            a.inplace_scaled_row_add(r1 as usize, r2 as usize, scalar);
+            mem::forget(a); // Prevent drop that would deallocate the matrix data
+        }
+
+        n
+    });
+
+    res.unwrap_or(0)
+}
+
+/// Multiplies `n` pairs of matrix handles in a single FFI call, writing
+/// a new handle for each product into `out`. Stops at the first pair
+/// that cannot be multiplied and returns the number of products
+/// written, so a return value of `n` means all succeeded.
+#[no_mangle]
+pub extern "C" fn batch_multiply_matrix(ptrs_a: *const *mut c_void, ptrs_b: *const *mut c_void, out: *mut *mut c_void, n: c_uint) -> c_uint
+{
+    let res = catch_unwind(|| {
+        let (lhs, rhs, products) = unsafe
+        {(
+            slice::from_raw_parts(ptrs_a, n as usize),
+            slice::from_raw_parts(ptrs_b, n as usize),
+            slice::from_raw_parts_mut(out, n as usize),
+        )};
+        let mut done = 0;
+
+        for i in 0..n as usize
+        {
+            let (a, b) = unsafe
+            {(
+                Box::from_raw(lhs[i] as *mut Matrix<c_double>),
+                Box::from_raw(rhs[i] as *mut Matrix<c_double>),
+            )};
+
+            let ab = a.multiply_matrix(&b);
+
+            mem::forget(a); // Prevent drop that would deallocate matrix data. We don't inform the
+            mem::forget(b); // caller that a or b will be deallocated, so we shouldn't do it here.
+
+            match ab
+            {
+                Ok(x)  => products[i] = Box::into_raw(Box::new(x)) as *mut c_void,
+                Err(_) => break,
+            }
+            done += 1;
+        }
+
+        done
+    });
+
+    res.unwrap_or(0)
+}
@@ -1,6 +1,20 @@
-/// Contains error type definitions for various functions in this crate. 
+/// Contains error type definitions for various functions in this crate.
 pub mod error;
-/// Contains the source for the traits implemented for and 
+/// Contains the `LuDecomposition<T>` type for solving linear systems
+/// repeatedly against the same factored matrix.
+pub mod lu;
+/// Contains the `SparseMatrix<T>` type for storing and solving large,
+/// mostly-zero systems in compressed sparse row layout.
+pub mod sparse;
+/// Contains the slice-based kernels behind the hot `Matrix<T>` row
+/// operations, with runtime-dispatched SIMD paths for `f32` and `f64`.
+pub mod simd;
+/// Contains the `MatrixView<'_, T>` type for slicing, transposing, and
+/// augmenting matrices without copying their values.
+pub mod view;
+/// Contains the small-buffer-optimized storage behind `Matrix<T>`.
+mod storage;
+/// Contains the source for the traits implemented for and
 /// operators invoving `Matrix<T>`.
 mod trait_impls;
 /// Contains `extern "C"` function definitions for linking this library
@@ -15,10 +29,12 @@ use std::mem::swap;
 use anyhow::{Error, Result};
 use error::*;
 use num_traits::Num;
+use simd::SimdKernel;
+use storage::MatrixStorage;
 pub use trait_impls::*;
 
 /// A helper trait to constrain the type of the elements of a `Matrix<T>`.
-pub trait Element<T>: Num + Copy + Debug + Display + AddAssign + MulAssign + SubAssign + Neg<Output = T> {}
+pub trait Element<T>: Num + Copy + Debug + Display + AddAssign + MulAssign + SubAssign + Neg<Output = T> + SimdKernel<T> {}
 
 impl Element<f32> for f32 {}
 impl Element<f64> for f64 {}
@@ -28,13 +44,15 @@ impl Element<i32> for i32 {}
 impl Element<i64> for i64 {}
 
 /// An MxN matrix stored as a single contiguous piece of memory.
+/// Matrices of up to 16 elements are stored entirely on the stack
+/// and never touch the allocator; larger ones spill to the heap.
 #[derive(Clone, Debug, PartialEq)]
 pub struct Matrix<T>
 where T: Element<T>
 {
     rows: usize,
     cols: usize,
-    vals: Vec<T>,
+    vals: MatrixStorage<T>,
 }
 
 impl <T> Matrix<T>
@@ -56,19 +74,12 @@ where T: Element<T>
     /// ```
     pub fn new(rows: usize, cols: usize) -> Matrix<T>
     {
-        let mut a = Matrix 
-        { 
-            rows, 
-            cols, 
-            vals: Vec::with_capacity(rows * cols),
-        };
-        
-        for _ in 0..a.vals.capacity()
+        Matrix
         {
-            a.vals.push(T::zero());
+            rows,
+            cols,
+            vals: MatrixStorage::zeroed(rows * cols),
         }
-
-        a
     }
 
     /// Constructs a new identity `Matrix<T>`.
@@ -123,7 +134,7 @@ where T: Element<T>
         Ok(Matrix {
             rows: vec.len() / cols,
             cols,
-            vals: vec,
+            vals: MatrixStorage::from_vec(vec),
         })
     }
 
@@ -146,7 +157,7 @@ where T: Element<T>
         {
             rows: 1,
             cols: vec.len(),
-            vals: vec,
+            vals: MatrixStorage::from_vec(vec),
         }
     }
 
@@ -171,7 +182,7 @@ where T: Element<T>
         {
             rows: vec.len(),
             cols: 1,
-            vals: vec,
+            vals: MatrixStorage::from_vec(vec),
         }
     }
 
@@ -231,6 +242,38 @@ where T: Element<T>
         self.vals.iter()
     }
 
+    /// Returns the contiguous slice of values backing a single row.
+    #[inline]
+    fn row_slice(&self, row: usize) -> &[T]
+    {
+        &self.vals[row * self.cols..(row + 1) * self.cols]
+    }
+
+    /// Returns the contiguous slice of values backing a single row, mutably.
+    #[inline]
+    fn row_slice_mut(&mut self, row: usize) -> &mut [T]
+    {
+        &mut self.vals[row * self.cols..(row + 1) * self.cols]
+    }
+
+    /// Returns mutable access to row `r1` alongside shared access to a
+    /// different row `r2` for the slice kernels.
+    #[inline]
+    fn row_pair_mut(&mut self, r1: usize, r2: usize) -> (&mut [T], &[T])
+    {
+        let cols = self.cols;
+        if r1 < r2
+        {
+            let (head, tail) = self.vals.split_at_mut(r2 * cols);
+            (&mut head[r1 * cols..(r1 + 1) * cols], &tail[..cols])
+        }
+        else
+        {
+            let (head, tail) = self.vals.split_at_mut(r1 * cols);
+            (&mut tail[..cols], &head[r2 * cols..(r2 + 1) * cols])
+        }
+    }
+
     /// Swaps the locations of two rows in the matrix.
     /// 
     /// # Example
@@ -253,10 +296,10 @@ where T: Element<T>
         let mut storage: T;
         for i in 0..self.cols
         {
-            storage       = self[(i, r1)];
-            self[(i, r1)] = self[(i, r2)];
-            self[(i, r2)] = storage;
-        } 
+            storage       = self[(r1, i)];
+            self[(r1, i)] = self[(r2, i)];
+            self[(r2, i)] = storage;
+        }
     }
 
     /// Scales the elements in a given row by a given scalar value.
@@ -273,10 +316,7 @@ where T: Element<T>
     /// ```
     pub fn inplace_row_scale(&mut self, row: usize, scalar: T)
     {
-        for i in 0..self.cols
-        {
-            self[(row, i)] *= scalar;
-        }
+        T::slice_scale(scalar, self.row_slice_mut(row));
     }
 
     /// Scales the elements in the matrix by a given scalar value.
@@ -326,11 +366,7 @@ where T: Element<T>
     /// ```
     pub fn inplace_row_add(&mut self, r1: usize, r2: usize)
     {
-        for i in 0..self.cols
-        {
-            let addend = self[(r2, i)];
-            self[(r1, i)] += addend;
-        }
+        self.inplace_scaled_row_add(r1, r2, T::one());
     }
 
     /// Adds a row `r2` to another row `r1` in the
@@ -354,11 +390,15 @@ where T: Element<T>
     /// ```
     pub fn inplace_scaled_row_add(&mut self, r1: usize, r2: usize, scalar: T)
     {
-        for i in 0..self.cols
+        if r1 == r2
         {
-            let addend = self[(r2, i)] * scalar;
-            self[(r1, i)] += addend;
+            // Adding a scaled copy of a row to itself is just a scale
+            T::slice_scale(T::one() + scalar, self.row_slice_mut(r1));
+            return;
         }
+
+        let (dst, src) = self.row_pair_mut(r1, r2);
+        T::slice_axpy(scalar, src, dst);
     }
 
     /// Returns the matrix multiplication product of this `Matrix<T>` and 
@@ -390,25 +430,126 @@ where T: Element<T>
             return Err(MatrixMultiplicationError.into())
         }
 
-        let n = self.cols;
         let mut result = Matrix::new(self.rows, a.cols);
+        multiply_rows_blocked(self, a, 0, &mut result.vals);
+
+        Ok(result)
+    }
+
+    /// Returns the matrix multiplication product of this `Matrix<T>` and
+    /// another `Matrix<T>` like `multiply_matrix`, but splits the rows of
+    /// the result across up to `threads` OS threads. Each thread runs the
+    /// same cache-blocked kernel over its own disjoint slice of the result,
+    /// so this is worthwhile once the operands are large enough (roughly
+    /// a few hundred rows) for the per-thread work to dwarf spawn cost.
+    ///
+    /// # Example
+    /// ```
+    /// use gmatlib::Matrix;
+    ///
+    /// let a: Matrix<f64> = Matrix::new_identity(64);
+    /// let b: Matrix<f64> = Matrix::new_identity(64);
+    ///
+    /// let c = a.multiply_matrix_blocked(&b, 4).unwrap();
+    ///
+    /// assert_eq!(c, Matrix::new_identity(64));
+    /// ```
+    pub fn multiply_matrix_blocked(&self, a: &Matrix<T>, threads: usize) -> Result<Matrix<T>>
+    where T: Send + Sync
+    {
+        if self.cols != a.rows
+        {
+            return Err(MatrixMultiplicationError.into())
+        }
+
+        let mut result = Matrix::new(self.rows, a.cols);
+        let chunk_rows = self.rows.div_ceil(threads.max(1));
+
+        std::thread::scope(|scope| {
+            for (chunk, dst) in result.vals.chunks_mut(chunk_rows * a.cols).enumerate()
+            {
+                scope.spawn(move || {
+                    multiply_rows_blocked(self, a, chunk * chunk_rows, dst);
+                });
+            }
+        });
+
+        Ok(result)
+    }
+
+    /// Computes the matrix-vector product of this `Matrix<T>` and the
+    /// column vector `x`, writing the result into the preallocated column
+    /// vector `out` instead of allocating a new matrix. This is the form
+    /// solver inner loops should use: the same `out` buffer can be reused
+    /// across every iteration. This operation will fail if `x` is not a
+    /// `cols` x 1 column vector or `out` is not a `rows` x 1 column vector.
+    ///
+    /// # Example
+    /// ```
+    /// use gmatlib::Matrix;
+    ///
+    /// let a: Matrix<i32> = Matrix::new_identity(2);
+    /// let x = Matrix::from_col_vec(vec![2, 3]);
+    /// let mut out = Matrix::new(2, 1);
+    ///
+    /// a.gemv_into(&x, &mut out).unwrap();
+    ///
+    /// assert_eq!(out, x);
+    /// ```
+    pub fn gemv_into(&self, x: &Matrix<T>, out: &mut Matrix<T>) -> Result<()>
+    {
+        if x.rows != self.cols || x.cols != 1
+        {
+            return Err(MatrixMultiplicationError.into())
+        }
+        if out.rows != self.rows || out.cols != 1
+        {
+            return Err(MatrixShapeMismatchError.into())
+        }
 
         for i in 0..self.rows
         {
-            for j in 0..a.cols
+            let mut sum = T::zero();
+            for (l, r) in self.row_slice(i).iter().zip(x.vals.iter())
             {
-                for x in 0..n
-                {
-                    result[(i, j)] += self[(i, x)] * a[(x, j)]
-                }
+                sum += *l * *r;
             }
+            out.vals[i] = sum;
         }
 
-        Ok(result)
+        Ok(())
+    }
+
+    /// Adds `scalar` times every element of `x` to the corresponding
+    /// element of this `Matrix<T>` in place, without allocating. This
+    /// operation will fail if the operands are not the same shape.
+    ///
+    /// # Example
+    /// ```
+    /// use gmatlib::Matrix;
+    ///
+    /// let mut a: Matrix<i32> = Matrix::new_identity(2);
+    /// let b: Matrix<i32> = Matrix::new_identity(2);
+    ///
+    /// a.axpy_into(2, &b).unwrap();
+    ///
+    /// assert_eq!(a[(0, 0)], 3);
+    /// assert_eq!(a[(0, 1)], 0);
+    /// ```
+    pub fn axpy_into(&mut self, scalar: T, x: &Matrix<T>) -> Result<()>
+    {
+        if x.rows != self.rows || x.cols != self.cols
+        {
+            return Err(MatrixShapeMismatchError.into())
+        }
+
+        T::slice_axpy(scalar, &x.vals, &mut self.vals);
+
+        Ok(())
     }
 
     /// Creates a new `Matrix<T>` with the columns of `a` appended to
-    /// the columns of `self`. This operation will fail if the number 
+    /// the columns of `self`. This operation will fail if the number
     /// of rows in `a` does not match the number of rows in `self`.
     /// 
     /// # Example
@@ -762,6 +903,36 @@ where T: Element<T>
 
 }
 
+/// The number of shared-dimension columns processed per tile of the
+/// blocked matrix multiplication kernel. 64 f64 rows of that width fit
+/// comfortably in L1 alongside the result row being accumulated.
+const _MUL_BLOCK_: usize = 64;
+
+/// Computes rows `row0..` of the product `lhs * rhs` into `dst`, which must
+/// be the contiguous storage for those result rows. The shared dimension is
+/// processed in tiles so the `rhs` rows touched by a tile stay cache-hot
+/// while every result row in the chunk accumulates against them, and the
+/// i-x-j ordering walks both operands row-wise so the axpy kernel streams
+/// whole contiguous rows at a time.
+fn multiply_rows_blocked<T>(lhs: &Matrix<T>, rhs: &Matrix<T>, row0: usize, dst: &mut [T])
+where T: Element<T>
+{
+    let rows = dst.len() / rhs.cols;
+
+    for xb in (0..lhs.cols).step_by(_MUL_BLOCK_)
+    {
+        let xe = (xb + _MUL_BLOCK_).min(lhs.cols);
+        for i in 0..rows
+        {
+            let dst_row = &mut dst[i * rhs.cols..(i + 1) * rhs.cols];
+            for x in xb..xe
+            {
+                T::slice_axpy(lhs[(row0 + i, x)], rhs.row_slice(x), dst_row);
+            }
+        }
+    }
+}
+
 /// Creates a new row vector `Matrix<T>`
 /// 
 /// # Example
@@ -0,0 +1,183 @@
+use anyhow::Result;
+use crate::{Matrix, Element};
+use crate::error::*;
+
+/// An LU factorization of a square `Matrix<T>` with partial (row) pivoting.
+///
+/// # Concept:
+/// Solving `Ax = b` by explicitly inverting `A` and multiplying costs roughly
+/// 3x the floating point operations of an LU solve and fails outright on any
+/// zero pivot. An `LuDecomposition<T>` instead factors `A` **once** into
+/// `PA = LU`, swapping rows past zero pivots as it goes, and then solves
+/// against any number of right-hand sides by forward- and back-substitution.
+/// This is the preferred way to repeatedly solve against the same matrix,
+/// e.g. in a Newton-Raphson iteration.
+#[derive(Clone, Debug, PartialEq)]
+pub struct LuDecomposition<T>
+where T: Element<T>
+{
+    lu: Matrix<T>,
+    perm: Vec<usize>,
+}
+
+impl <T> LuDecomposition<T>
+where T: Element<T> + PartialOrd
+{
+    /// Attempts to factor the given `Matrix<T>` into its LU decomposition,
+    /// consuming the matrix in the process. This operation will fail if the
+    /// matrix is not square or is singular to working precision.
+    ///
+    /// # Example
+    /// ```
+    /// use gmatlib::Matrix;
+    /// use gmatlib::lu::LuDecomposition;
+    ///
+    /// let a = Matrix::from_vec(
+    ///     2,
+    ///     vec![4.0, 3.0,
+    ///          6.0, 3.0]
+    /// ).unwrap();
+    ///
+    /// let lu = LuDecomposition::try_from_matrix(a)
+    ///     .expect("failed to factor matrix");
+    /// ```
+    pub fn try_from_matrix(a: Matrix<T>) -> Result<LuDecomposition<T>>
+    {
+        if a.get_rows() != a.get_cols()
+        {
+            return Err(NonSquareMatrixError.into())
+        }
+
+        let n = a.get_rows();
+        let mut lu = a;
+        let mut perm = Vec::from_iter(0..n);
+
+        for k in 0..n
+        {
+            // Find the row with the largest magnitude value in column k...
+            let mut pivot_row = k;
+            let mut pivot_mag = magnitude(lu[(k, k)]);
+            for i in k+1..n
+            {
+                let mag = magnitude(lu[(i, k)]);
+                if mag > pivot_mag
+                {
+                    pivot_row = i;
+                    pivot_mag = mag;
+                }
+            }
+
+            // ...refusing to factor the matrix if no usable pivot exists...
+            if lu[(pivot_row, k)] == T::zero()
+            {
+                return Err(SingularMatrixError.into())
+            }
+
+            // ...and swap it into the pivot position.
+            if pivot_row != k
+            {
+                lu.inplace_row_swap(k, pivot_row);
+                perm.swap(k, pivot_row);
+            }
+
+            // Eliminate below the pivot, storing the multipliers in the
+            // lower triangle where the eliminated values used to live.
+            for i in k+1..n
+            {
+                let multiplier = lu[(i, k)] / lu[(k, k)];
+                lu[(i, k)] = multiplier;
+                for j in k+1..n
+                {
+                    let subtrahend = multiplier * lu[(k, j)];
+                    lu[(i, j)] -= subtrahend;
+                }
+            }
+        }
+
+        Ok(LuDecomposition { lu, perm })
+    }
+
+    /// Solves `Ax = b` for `x` using this factorization of `A`, where `b` is
+    /// given as a column vector `Matrix<T>` (or a matrix of several columns
+    /// to solve against multiple right-hand sides at once). This operation
+    /// will fail if the number of rows in `b` does not match the dimension
+    /// of the factored matrix.
+    ///
+    /// # Example
+    /// ```
+    /// use gmatlib::{col_vec, Matrix};
+    /// use gmatlib::lu::LuDecomposition;
+    ///
+    /// let a = Matrix::from_vec(
+    ///     2,
+    ///     vec![4.0, 3.0,
+    ///          6.0, 3.0]
+    /// ).unwrap();
+    ///
+    /// let lu = LuDecomposition::try_from_matrix(a).unwrap();
+    ///
+    /// // solve the same factorization against as many right-hand
+    /// // sides as needed:
+    /// let x: Vec<f64> = lu.solve(&col_vec![10.0, 12.0]).unwrap().into();
+    ///
+    /// assert!((x[0] - 1.0).abs() < 1e-12);
+    /// assert!((x[1] - 2.0).abs() < 1e-12);
+    /// ```
+    pub fn solve(&self, b: &Matrix<T>) -> Result<Matrix<T>>
+    {
+        let n = self.lu.get_rows();
+        if b.get_rows() != n
+        {
+            return Err(MatrixMultiplicationError.into())
+        }
+
+        let cols = b.get_cols();
+        let mut x: Matrix<T> = Matrix::new(n, cols);
+
+        for c in 0..cols
+        {
+            // Apply the row permutation to the right-hand side
+            for i in 0..n
+            {
+                x[(i, c)] = b[(self.perm[i], c)];
+            }
+
+            // Forward-substitute through the (unit) lower triangle
+            for i in 1..n
+            {
+                for j in 0..i
+                {
+                    let subtrahend = self.lu[(i, j)] * x[(j, c)];
+                    x[(i, c)] -= subtrahend;
+                }
+            }
+
+            // Back-substitute through the upper triangle
+            for i in (0..n).rev()
+            {
+                for j in i+1..n
+                {
+                    let subtrahend = self.lu[(i, j)] * x[(j, c)];
+                    x[(i, c)] -= subtrahend;
+                }
+                x[(i, c)] = x[(i, c)] / self.lu[(i, i)];
+            }
+        }
+
+        Ok(x)
+    }
+}
+
+/// Returns the magnitude of a value for pivot selection.
+fn magnitude<T>(x: T) -> T
+where T: Element<T> + PartialOrd
+{
+    if x < T::zero()
+    {
+        -x
+    }
+    else
+    {
+        x
+    }
+}
@@ -0,0 +1,239 @@
+use std::ops::AddAssign;
+use num_traits::Num;
+
+/// A helper trait providing the contiguous-slice kernels that the hot
+/// `Matrix<T>` row operations are built out of.
+///
+/// # Concept:
+/// Indexing element-by-element through the `Index` impl performs bounds
+/// arithmetic per access and defeats autovectorization. These kernels
+/// instead operate on whole row slices at a time. Every `Element<T>` type
+/// gets a scalar implementation; `f32` and `f64` override it with explicit
+/// AVX paths selected at runtime by CPU feature detection, which is where
+/// Gauss-Jordan elimination and matrix multiplication spend nearly all of
+/// their time.
+pub trait SimdKernel<T>: Num + Copy + AddAssign
+{
+    /// Computes `y[i] += a * x[i]` over a pair of equal-length slices.
+    fn slice_axpy(a: T, x: &[T], y: &mut [T]);
+
+    /// Computes `x[i] *= a` over a slice.
+    fn slice_scale(a: T, x: &mut [T]);
+}
+
+/// Computes `y[i] += a * x[i]` one element at a time.
+#[inline]
+fn scalar_axpy<T>(a: T, x: &[T], y: &mut [T])
+where T: Num + Copy + AddAssign
+{
+    for i in 0..x.len().min(y.len())
+    {
+        y[i] += a * x[i];
+    }
+}
+
+/// Computes `x[i] *= a` one element at a time.
+#[inline]
+fn scalar_scale<T>(a: T, x: &mut [T])
+where T: Num + Copy
+{
+    for val in x
+    {
+        *val = *val * a;
+    }
+}
+
+/// Implements `SimdKernel<T>` with the plain scalar loops for types that
+/// have no vectorized path.
+macro_rules! impl_scalar_kernel {
+    ($($t:ty),+) => {
+        $(
+            impl SimdKernel<$t> for $t
+            {
+                #[inline]
+                fn slice_axpy(a: $t, x: &[$t], y: &mut [$t])
+                {
+                    scalar_axpy(a, x, y);
+                }
+
+                #[inline]
+                fn slice_scale(a: $t, x: &mut [$t])
+                {
+                    scalar_scale(a, x);
+                }
+            }
+        )+
+    };
+}
+
+impl_scalar_kernel!(i8, i16, i32, i64);
+
+impl SimdKernel<f64> for f64
+{
+    #[inline]
+    fn slice_axpy(a: f64, x: &[f64], y: &mut [f64])
+    {
+        #[cfg(target_arch = "x86_64")]
+        if is_x86_feature_detected!("avx")
+        {
+            // SAFETY: the AVX feature was just detected at runtime
+            unsafe { axpy_f64_avx(a, x, y) };
+            return;
+        }
+
+        scalar_axpy(a, x, y);
+    }
+
+    #[inline]
+    fn slice_scale(a: f64, x: &mut [f64])
+    {
+        #[cfg(target_arch = "x86_64")]
+        if is_x86_feature_detected!("avx")
+        {
+            // SAFETY: the AVX feature was just detected at runtime
+            unsafe { scale_f64_avx(a, x) };
+            return;
+        }
+
+        scalar_scale(a, x);
+    }
+}
+
+impl SimdKernel<f32> for f32
+{
+    #[inline]
+    fn slice_axpy(a: f32, x: &[f32], y: &mut [f32])
+    {
+        #[cfg(target_arch = "x86_64")]
+        if is_x86_feature_detected!("avx")
+        {
+            // SAFETY: the AVX feature was just detected at runtime
+            unsafe { axpy_f32_avx(a, x, y) };
+            return;
+        }
+
+        scalar_axpy(a, x, y);
+    }
+
+    #[inline]
+    fn slice_scale(a: f32, x: &mut [f32])
+    {
+        #[cfg(target_arch = "x86_64")]
+        if is_x86_feature_detected!("avx")
+        {
+            // SAFETY: the AVX feature was just detected at runtime
+            unsafe { scale_f32_avx(a, x) };
+            return;
+        }
+
+        scalar_scale(a, x);
+    }
+}
+
+/// Computes `y[i] += a * x[i]` four f64 lanes at a time.
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx")]
+unsafe fn axpy_f64_avx(a: f64, x: &[f64], y: &mut [f64])
+{
+    use std::arch::x86_64::*;
+
+    let n = x.len().min(y.len());
+    let a_lanes = _mm256_set1_pd(a);
+    let mut i = 0;
+
+    while i + 4 <= n
+    {
+        let x_lanes = _mm256_loadu_pd(x.as_ptr().add(i));
+        let y_lanes = _mm256_loadu_pd(y.as_ptr().add(i));
+        _mm256_storeu_pd(
+            y.as_mut_ptr().add(i),
+            _mm256_add_pd(y_lanes, _mm256_mul_pd(a_lanes, x_lanes))
+        );
+        i += 4;
+    }
+
+    while i < n
+    {
+        y[i] += a * x[i];
+        i += 1;
+    }
+}
+
+/// Computes `x[i] *= a` four f64 lanes at a time.
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx")]
+unsafe fn scale_f64_avx(a: f64, x: &mut [f64])
+{
+    use std::arch::x86_64::*;
+
+    let n = x.len();
+    let a_lanes = _mm256_set1_pd(a);
+    let mut i = 0;
+
+    while i + 4 <= n
+    {
+        let x_lanes = _mm256_loadu_pd(x.as_ptr().add(i));
+        _mm256_storeu_pd(x.as_mut_ptr().add(i), _mm256_mul_pd(a_lanes, x_lanes));
+        i += 4;
+    }
+
+    while i < n
+    {
+        x[i] *= a;
+        i += 1;
+    }
+}
+
+/// Computes `y[i] += a * x[i]` eight f32 lanes at a time.
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx")]
+unsafe fn axpy_f32_avx(a: f32, x: &[f32], y: &mut [f32])
+{
+    use std::arch::x86_64::*;
+
+    let n = x.len().min(y.len());
+    let a_lanes = _mm256_set1_ps(a);
+    let mut i = 0;
+
+    while i + 8 <= n
+    {
+        let x_lanes = _mm256_loadu_ps(x.as_ptr().add(i));
+        let y_lanes = _mm256_loadu_ps(y.as_ptr().add(i));
+        _mm256_storeu_ps(
+            y.as_mut_ptr().add(i),
+            _mm256_add_ps(y_lanes, _mm256_mul_ps(a_lanes, x_lanes))
+        );
+        i += 8;
+    }
+
+    while i < n
+    {
+        y[i] += a * x[i];
+        i += 1;
+    }
+}
+
+/// Computes `x[i] *= a` eight f32 lanes at a time.
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx")]
+unsafe fn scale_f32_avx(a: f32, x: &mut [f32])
+{
+    use std::arch::x86_64::*;
+
+    let n = x.len();
+    let a_lanes = _mm256_set1_ps(a);
+    let mut i = 0;
+
+    while i + 8 <= n
+    {
+        let x_lanes = _mm256_loadu_ps(x.as_ptr().add(i));
+        _mm256_storeu_ps(x.as_mut_ptr().add(i), _mm256_mul_ps(a_lanes, x_lanes));
+        i += 8;
+    }
+
+    while i < n
+    {
+        x[i] *= a;
+        i += 1;
+    }
+}
@@ -0,0 +1,312 @@
+use anyhow::Result;
+use crate::{Matrix, Element};
+use crate::error::*;
+
+/// An MxN sparse matrix stored in compressed sparse row (CSR) layout.
+///
+/// # Concept:
+/// Jacobians of large nodal systems are overwhelmingly zeros: each node only
+/// touches a handful of neighbors, so storing and factoring a dense
+/// `Matrix<T>` wastes memory quadratically and solve time cubically in the
+/// node count. A `SparseMatrix<T>` stores only the structurally nonzero
+/// entries, supports matrix-vector products in O(nnz) time, and offers an
+/// iterative Gauss-Seidel solve that never materializes a dense factor.
+#[derive(Clone, Debug, PartialEq)]
+pub struct SparseMatrix<T>
+where T: Element<T>
+{
+    rows: usize,
+    cols: usize,
+    row_ptr: Vec<usize>,
+    col_idx: Vec<usize>,
+    vals: Vec<T>,
+}
+
+impl <T> SparseMatrix<T>
+where T: Element<T>
+{
+    /// Constructs a `SparseMatrix<T>` from a list of `(row, col, value)`
+    /// triplets. Duplicate entries are summed and explicit zeros are dropped.
+    /// This operation will fail if any triplet indexes outside the given
+    /// dimensions.
+    ///
+    /// # Example
+    /// ```
+    /// use gmatlib::sparse::SparseMatrix;
+    ///
+    /// let a = SparseMatrix::from_triplets(
+    ///     2, 2,
+    ///     vec![(0, 0, 4.0), (1, 1, 3.0), (0, 1, 1.0)]
+    /// ).unwrap();
+    ///
+    /// assert_eq!(a.nnz(), 3);
+    /// assert_eq!(a.get(1, 0), 0.0);
+    /// ```
+    pub fn from_triplets(rows: usize, cols: usize, triplets: Vec<(usize, usize, T)>) -> Result<SparseMatrix<T>>
+    {
+        let mut entries = triplets;
+        for &(i, j, _) in &entries
+        {
+            if i >= rows || j >= cols
+            {
+                return Err(SparseMatrixFromTripletsError { rows, cols, i, j }.into())
+            }
+        }
+        entries.sort_by_key(|&(i, j, _)| (i, j));
+
+        let mut row_ptr = vec![0usize; rows + 1];
+        let mut col_idx = Vec::with_capacity(entries.len());
+        let mut vals: Vec<T> = Vec::with_capacity(entries.len());
+        let mut last_coord = None;
+
+        for (i, j, v) in entries
+        {
+            if v == T::zero()
+            {
+                continue;
+            }
+
+            // Combine duplicate coordinates rather than storing them twice
+            if last_coord == Some((i, j))
+            {
+                let last = vals.len() - 1;
+                vals[last] += v;
+            }
+            else
+            {
+                col_idx.push(j);
+                vals.push(v);
+                last_coord = Some((i, j));
+            }
+            row_ptr[i + 1] = col_idx.len();
+        }
+
+        // Rows with no entries inherit the previous row's end offset
+        for i in 1..rows + 1
+        {
+            if row_ptr[i] < row_ptr[i - 1]
+            {
+                row_ptr[i] = row_ptr[i - 1];
+            }
+        }
+
+        Ok(SparseMatrix { rows, cols, row_ptr, col_idx, vals })
+    }
+
+    /// Constructs a `SparseMatrix<T>` from a dense `Matrix<T>`, keeping
+    /// only the nonzero entries.
+    ///
+    /// # Example
+    /// ```
+    /// use gmatlib::Matrix;
+    /// use gmatlib::sparse::SparseMatrix;
+    ///
+    /// let a: Matrix<f64> = Matrix::new_identity(100);
+    /// let s = SparseMatrix::from_dense(&a);
+    ///
+    /// assert_eq!(s.nnz(), 100);
+    /// ```
+    pub fn from_dense(a: &Matrix<T>) -> SparseMatrix<T>
+    {
+        let mut triplets = vec![];
+        for i in 0..a.get_rows()
+        {
+            for j in 0..a.get_cols()
+            {
+                if a[(i, j)] != T::zero()
+                {
+                    triplets.push((i, j, a[(i, j)]));
+                }
+            }
+        }
+
+        // Infallible: triplets are in bounds by construction
+        SparseMatrix::from_triplets(a.get_rows(), a.get_cols(), triplets).unwrap()
+    }
+
+    /// Expands this `SparseMatrix<T>` into an equivalent dense `Matrix<T>`.
+    pub fn to_dense(&self) -> Matrix<T>
+    {
+        let mut a = Matrix::new(self.rows, self.cols);
+        for i in 0..self.rows
+        {
+            for k in self.row_ptr[i]..self.row_ptr[i + 1]
+            {
+                a[(i, self.col_idx[k])] = self.vals[k];
+            }
+        }
+        a
+    }
+
+    /// Returns the number of rows in the `SparseMatrix<T>`.
+    pub fn get_rows(&self) -> usize
+    {
+        self.rows
+    }
+
+    /// Returns the number of columns in the `SparseMatrix<T>`.
+    pub fn get_cols(&self) -> usize
+    {
+        self.cols
+    }
+
+    /// Returns the number of structurally nonzero entries stored.
+    pub fn nnz(&self) -> usize
+    {
+        self.vals.len()
+    }
+
+    /// Returns the value stored at the given row and column, or zero if the
+    /// coordinate is not structurally nonzero.
+    ///
+    /// # Panics
+    /// This operation will panic if the coordinate is out of bounds, matching
+    /// the behavior of indexing into a dense `Matrix<T>`.
+    pub fn get(&self, row: usize, col: usize) -> T
+    {
+        if row >= self.rows || col >= self.cols
+        {
+            panic!("index out of bounds: the matrix has {} rows and {} cols but the index was [({}, {})]", self.rows, self.cols, row, col)
+        }
+
+        for k in self.row_ptr[row]..self.row_ptr[row + 1]
+        {
+            if self.col_idx[k] == col
+            {
+                return self.vals[k];
+            }
+        }
+        T::zero()
+    }
+
+    /// Returns the matrix-vector product of this `SparseMatrix<T>` and a
+    /// dense column vector given as a `Matrix<T>`, in O(nnz) time. This
+    /// operation will fail if the operand is not a column vector with a
+    /// number of rows matching this matrix's number of columns.
+    ///
+    /// # Example
+    /// ```
+    /// use gmatlib::{col_vec, Matrix};
+    /// use gmatlib::sparse::SparseMatrix;
+    ///
+    /// let a = SparseMatrix::from_triplets(
+    ///     2, 2,
+    ///     vec![(0, 0, 2.0), (1, 1, 3.0)]
+    /// ).unwrap();
+    ///
+    /// let y: Vec<f64> = a.multiply_col_vec(&col_vec![1.0, 1.0]).unwrap().into();
+    ///
+    /// assert_eq!(y, vec![2.0, 3.0]);
+    /// ```
+    pub fn multiply_col_vec(&self, x: &Matrix<T>) -> Result<Matrix<T>>
+    {
+        if x.get_cols() != 1 || x.get_rows() != self.cols
+        {
+            return Err(MatrixMultiplicationError.into())
+        }
+
+        let mut y = Matrix::new(self.rows, 1);
+        for i in 0..self.rows
+        {
+            for k in self.row_ptr[i]..self.row_ptr[i + 1]
+            {
+                y[(i, 0)] += self.vals[k] * x[(self.col_idx[k], 0)];
+            }
+        }
+
+        Ok(y)
+    }
+}
+
+impl <T> SparseMatrix<T>
+where T: Element<T> + PartialOrd
+{
+    /// Attempts to iteratively solve `Ax = b` with the Gauss-Seidel method,
+    /// never forming a dense factorization. The solve succeeds once the
+    /// largest per-element update falls within `margin`, and fails if any
+    /// diagonal entry is structurally zero or if no solution is found within
+    /// `limit` sweeps.
+    ///
+    /// Convergence is only guaranteed for diagonally dominant systems;
+    /// callers with general matrices should fall back to a dense
+    /// `LuDecomposition<T>` of `to_dense()` when this returns an error.
+    ///
+    /// # Example
+    /// ```
+    /// use gmatlib::{col_vec, Matrix};
+    /// use gmatlib::sparse::SparseMatrix;
+    ///
+    /// let a = SparseMatrix::from_triplets(
+    ///     2, 2,
+    ///     vec![(0, 0, 4.0), (0, 1, 1.0),
+    ///          (1, 0, 1.0), (1, 1, 3.0)]
+    /// ).unwrap();
+    ///
+    /// let x: Vec<f64> = a.try_solve_gauss_seidel(&col_vec![9.0, 7.0], 1e-10, 100)
+    ///     .unwrap()
+    ///     .into();
+    ///
+    /// assert!((x[0] - 20.0/11.0).abs() < 1e-8);
+    /// assert!((x[1] - 19.0/11.0).abs() < 1e-8);
+    /// ```
+    pub fn try_solve_gauss_seidel(&self, b: &Matrix<T>, margin: T, limit: usize) -> Result<Matrix<T>>
+    {
+        if self.rows != self.cols
+        {
+            return Err(NonSquareMatrixError.into())
+        }
+        if b.get_cols() != 1 || b.get_rows() != self.rows
+        {
+            return Err(MatrixMultiplicationError.into())
+        }
+
+        let n = self.rows;
+        let mut x: Matrix<T> = Matrix::new(n, 1);
+
+        for _ in 0..limit
+        {
+            let mut worst_update = T::zero();
+            for i in 0..n
+            {
+                let mut sum = b[(i, 0)];
+                let mut diag = T::zero();
+                for k in self.row_ptr[i]..self.row_ptr[i + 1]
+                {
+                    let j = self.col_idx[k];
+                    if j == i
+                    {
+                        diag = self.vals[k];
+                    }
+                    else
+                    {
+                        sum -= self.vals[k] * x[(j, 0)];
+                    }
+                }
+
+                if diag == T::zero()
+                {
+                    return Err(SparseSolveError::MissingDiagonal.into())
+                }
+
+                let next = sum / diag;
+                let mut update = next - x[(i, 0)];
+                if update < T::zero()
+                {
+                    update = -update;
+                }
+                if update > worst_update
+                {
+                    worst_update = update;
+                }
+                x[(i, 0)] = next;
+            }
+
+            if worst_update <= margin
+            {
+                return Ok(x);
+            }
+        }
+
+        Err(SparseSolveError::DidNotConverge.into())
+    }
+}
@@ -0,0 +1,139 @@
+use std::fmt::Debug;
+use std::ops::{Deref, DerefMut};
+use crate::Element;
+
+/// The number of elements a `Matrix<T>` can hold before its storage
+/// spills to the heap.
+pub const _INLINE_CAP_: usize = 16;
+
+/// The backing storage of a `Matrix<T>`.
+///
+/// # Concept:
+/// The overwhelming majority of matrices created by downstream solver
+/// code are tiny column vectors and 3x3 temporaries, so paying a heap
+/// allocation for each one is pure overhead. Storage up to `_INLINE_CAP_`
+/// elements lives directly inside the matrix on the stack; anything
+/// larger spills to a `Vec<T>`. Both variants dereference to the same
+/// contiguous slice, so the rest of the crate is agnostic to which one
+/// it is operating on.
+#[derive(Clone)]
+pub enum MatrixStorage<T>
+where T: Element<T>
+{
+    Inline
+    {
+        buf: [T; _INLINE_CAP_],
+        len: usize,
+    },
+    Heap(Vec<T>),
+}
+
+impl <T> MatrixStorage<T>
+where T: Element<T>
+{
+    /// Creates zero-filled storage for `len` elements, inline if they fit.
+    pub fn zeroed(len: usize) -> MatrixStorage<T>
+    {
+        if len <= _INLINE_CAP_
+        {
+            MatrixStorage::Inline
+            {
+                buf: [T::zero(); _INLINE_CAP_],
+                len,
+            }
+        }
+        else
+        {
+            MatrixStorage::Heap(vec![T::zero(); len])
+        }
+    }
+
+    /// Creates storage from an existing `Vec<T>`, copying it inline if it
+    /// fits so that every later clone of the matrix skips the allocator.
+    pub fn from_vec(vec: Vec<T>) -> MatrixStorage<T>
+    {
+        if vec.len() <= _INLINE_CAP_
+        {
+            let mut buf = [T::zero(); _INLINE_CAP_];
+            buf[..vec.len()].copy_from_slice(&vec);
+            MatrixStorage::Inline
+            {
+                buf,
+                len: vec.len(),
+            }
+        }
+        else
+        {
+            MatrixStorage::Heap(vec)
+        }
+    }
+
+    /// Moves the stored elements out into a `Vec<T>`.
+    pub fn into_vec(self) -> Vec<T>
+    {
+        match self
+        {
+            MatrixStorage::Inline { buf, len } => buf[..len].to_vec(),
+            MatrixStorage::Heap(vec) => vec,
+        }
+    }
+}
+
+impl <T> Deref for MatrixStorage<T>
+where T: Element<T>
+{
+    type Target = [T];
+
+    #[inline]
+    fn deref(&self) -> &[T]
+    {
+        match self
+        {
+            MatrixStorage::Inline { buf, len } => &buf[..*len],
+            MatrixStorage::Heap(vec) => vec,
+        }
+    }
+}
+
+impl <T> DerefMut for MatrixStorage<T>
+where T: Element<T>
+{
+    #[inline]
+    fn deref_mut(&mut self) -> &mut [T]
+    {
+        match self
+        {
+            MatrixStorage::Inline { buf, len } => &mut buf[..*len],
+            MatrixStorage::Heap(vec) => vec,
+        }
+    }
+}
+
+impl <T> From<Vec<T>> for MatrixStorage<T>
+where T: Element<T>
+{
+    fn from(vec: Vec<T>) -> MatrixStorage<T>
+    {
+        MatrixStorage::from_vec(vec)
+    }
+}
+
+impl <T> PartialEq for MatrixStorage<T>
+where T: Element<T>
+{
+    /// Compares the stored elements, regardless of whether either side
+    /// happens to live inline or on the heap.
+    fn eq(&self, other: &Self) -> bool
+    {
+        self[..] == other[..]
+    }
+}
+
+impl <T> Debug for MatrixStorage<T>
+where T: Element<T>
+{
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result
+    {
+        self[..].fmt(f)
+    }
+}
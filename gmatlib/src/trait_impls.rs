@@ -98,9 +98,10 @@ where T: Element<T>
     ///          14, 16, 18]
     /// );
     /// ```
-    fn add(self, rhs: Self) -> Self::Output 
+    fn add(mut self, rhs: Self) -> Self::Output
     {
-        &self + &rhs
+        self += &rhs;
+        self
     }
 }
 
@@ -137,9 +138,11 @@ where T: Element<T>
     ///          14, 16, 18]
     /// );
     /// ```
-    fn add(self, rhs: Matrix<T>) -> Self::Output 
+    fn add(self, mut rhs: Matrix<T>) -> Self::Output
     {
-        self + &rhs
+        // Addition commutes, so the owned right operand's buffer is reused
+        rhs += self;
+        rhs
     }
 }
 
@@ -176,9 +179,10 @@ where T: Element<T>
     ///          14, 16, 18]
     /// );
     /// ```
-    fn add(self, rhs: &Matrix<T>) -> Self::Output 
+    fn add(mut self, rhs: &Matrix<T>) -> Self::Output
     {
-        &self + rhs
+        self += rhs;
+        self
     }
 }
 
@@ -224,10 +228,10 @@ where T: Element<T>
         }
 
         let mut ret_val = Matrix::new(self.rows, self.cols);
-        ret_val.vals = Vec::from_iter(
-            zip(&self.vals, &rhs.vals)
-                .map(|(l, r)| *l + *r)
-        );
+        for (dst, (l, r)) in zip(ret_val.vals.iter_mut(), zip(self.vals.iter(), rhs.vals.iter()))
+        {
+            *dst = *l + *r;
+        }
         ret_val
     }
 }
@@ -235,18 +239,24 @@ where T: Element<T>
 impl <T> AddAssign for Matrix<T>
 where T: Element<T>
 {
-    fn add_assign(&mut self, rhs: Self) 
+    fn add_assign(&mut self, rhs: Self)
     {
-        if self.rows != rhs.rows || 
+        *self += &rhs;
+    }
+}
+
+impl <T> AddAssign<&Matrix<T>> for Matrix<T>
+where T: Element<T>
+{
+    fn add_assign(&mut self, rhs: &Matrix<T>)
+    {
+        if self.rows != rhs.rows ||
            self.cols != rhs.cols
         {
             panic!("cannot add elements of matrices with different sizes")
         }
 
-        for (i, elem) in rhs.iter().enumerate()
-        {
-            self.vals[i] += *elem;
-        }
+        T::slice_axpy(T::one(), &rhs.vals, &mut self.vals);
     }
 }
 
@@ -284,8 +294,9 @@ where T: Element<T>
     ///          -6, -6, -6]
     /// );
     /// ```
-    fn sub(self, rhs: Matrix<T>) -> Self::Output {
-        &self - &rhs
+    fn sub(mut self, rhs: Matrix<T>) -> Self::Output {
+        self -= &rhs;
+        self
     }
 }
 
@@ -322,8 +333,19 @@ where T: Element<T>
     ///          -6, -6, -6]
     /// );
     /// ```
-    fn sub(self, rhs: Matrix<T>) -> Self::Output {
-        self - &rhs
+    fn sub(self, mut rhs: Matrix<T>) -> Self::Output {
+        if self.rows != rhs.rows ||
+           self.cols != rhs.cols
+        {
+            panic!("cannot subtract elements of matrices with different sizes")
+        }
+
+        // The owned right operand's buffer is reused for the result
+        for (dst, l) in zip(rhs.vals.iter_mut(), self.vals.iter())
+        {
+            *dst = *l - *dst;
+        }
+        rhs
     }
 }
 
@@ -360,8 +382,9 @@ where T: Element<T>
     ///          -6, -6, -6]
     /// );
     /// ```
-    fn sub(self, rhs: &Matrix<T>) -> Self::Output {
-        &self - rhs
+    fn sub(mut self, rhs: &Matrix<T>) -> Self::Output {
+        self -= rhs;
+        self
     }
 }
 
@@ -407,10 +430,10 @@ where T: Element<T>
         }
 
         let mut ret_val = Matrix::new(self.rows, self.cols);
-        ret_val.vals = Vec::from_iter(
-            zip(&self.vals, &rhs.vals)
-                .map(|(l, r)| *l - *r)
-        );
+        for (dst, (l, r)) in zip(ret_val.vals.iter_mut(), zip(self.vals.iter(), rhs.vals.iter()))
+        {
+            *dst = *l - *r;
+        }
         ret_val
     }
 }
@@ -418,18 +441,24 @@ where T: Element<T>
 impl <T> SubAssign for Matrix<T>
 where T: Element<T>
 {
-    fn sub_assign(&mut self, rhs: Self) 
+    fn sub_assign(&mut self, rhs: Self)
     {
-        if self.rows != rhs.rows || 
+        *self -= &rhs;
+    }
+}
+
+impl <T> SubAssign<&Matrix<T>> for Matrix<T>
+where T: Element<T>
+{
+    fn sub_assign(&mut self, rhs: &Matrix<T>)
+    {
+        if self.rows != rhs.rows ||
            self.cols != rhs.cols
         {
             panic!("cannot subtract elements of matrices with different sizes")
         }
 
-        for (i, elem) in rhs.iter().enumerate()
-        {
-            self.vals[i] -= *elem;
-        }
+        T::slice_axpy(T::zero() - T::one(), &rhs.vals, &mut self.vals);
     }
 }
 
@@ -659,11 +688,10 @@ where T: Element<T>
     ///          0, 0, 4]
     /// );
     /// ```
-    fn mul(self, rhs: T) -> Self::Output {
-        let mut result = self.clone();
-        result.inplace_scale(rhs);
-        result
-    }   
+    fn mul(mut self, rhs: T) -> Self::Output {
+        self.inplace_scale(rhs);
+        self
+    }
 }
 
 impl <T> Mul<T> for &Matrix<T>
@@ -729,7 +757,7 @@ where T: Element<T>
     /// assert_eq!(five, a_vec[4]);
     /// ```
     fn from(value: Matrix<T>) -> Self {
-        value.vals
+        value.vals.into_vec()
     }
 }
 
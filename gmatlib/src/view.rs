@@ -0,0 +1,338 @@
+use std::ops::{Add, Index, Mul, Sub};
+use anyhow::Result;
+use crate::{Matrix, Element};
+use crate::error::*;
+
+/// A borrowed, zero-copy window into the values of a `Matrix<T>`.
+///
+/// # Concept:
+/// `Matrix::subset` and `Matrix::transpose` allocate and copy a whole new
+/// matrix, which shows up prominently in profiles when result extraction
+/// slices thousands of matrices in a loop. A `MatrixView<'_, T>` instead
+/// describes a rectangular region of the parent's contiguous storage with
+/// an offset and a stride per axis, so slicing and transposing are O(1)
+/// and allocation-free. Views support the same indexing and arithmetic as
+/// owned matrices; converting back to an owned `Matrix<T>` is the only
+/// operation that copies.
+#[derive(Clone, Copy, Debug)]
+pub struct MatrixView<'a, T>
+where T: Element<T>
+{
+    vals: &'a [T],
+    offset: usize,
+    rows: usize,
+    cols: usize,
+    row_stride: usize,
+    col_stride: usize,
+}
+
+impl <T> Matrix<T>
+where T: Element<T>
+{
+    /// Returns a borrowed `MatrixView<'_, T>` of this entire matrix
+    /// without copying any values.
+    ///
+    /// # Example
+    /// ```
+    /// use gmatlib::Matrix;
+    ///
+    /// let a: Matrix<i32> = Matrix::new_identity(3);
+    /// let v = a.as_view();
+    ///
+    /// assert_eq!(v[(1, 1)], 1);
+    /// assert_eq!(v[(1, 2)], 0);
+    /// ```
+    pub fn as_view(&self) -> MatrixView<'_, T>
+    {
+        MatrixView
+        {
+            vals: self.iter().as_slice(),
+            offset: 0,
+            rows: self.get_rows(),
+            cols: self.get_cols(),
+            row_stride: self.get_cols(),
+            col_stride: 1,
+        }
+    }
+
+    /// Returns a borrowed `MatrixView<'_, T>` of the rows in a range from
+    /// `r1` to `r2` and columns in a range from `c1` to `c2` without
+    /// copying any values. This is the allocation-free counterpart of
+    /// `Matrix::subset`.
+    ///
+    /// # Panics
+    /// This operation will panic under the same conditions as
+    /// `Matrix::subset`.
+    ///
+    /// # Example
+    /// ```
+    /// use gmatlib::Matrix;
+    ///
+    /// let a: Matrix<i32> = Matrix::new_identity(3);
+    ///
+    /// // Grab the upper right of the identity matrix
+    /// let b = a.subset_view(0, 1, 1, 2);
+    ///
+    /// assert_eq!(b.to_matrix(), a.subset(0, 1, 1, 2));
+    /// ```
+    pub fn subset_view(&self, r1: usize, c1: usize, r2: usize, c2: usize) -> MatrixView<'_, T>
+    {
+        self.as_view().subset(r1, c1, r2, c2)
+    }
+}
+
+impl <'a, T> MatrixView<'a, T>
+where T: Element<T>
+{
+    /// Returns the number of rows visible through the view.
+    pub fn get_rows(&self) -> usize
+    {
+        self.rows
+    }
+
+    /// Returns the number of columns visible through the view.
+    pub fn get_cols(&self) -> usize
+    {
+        self.cols
+    }
+
+    /// Returns a lazily-transposed view of the same values. This simply
+    /// swaps the view's axes and strides, so it is O(1) and never touches
+    /// the underlying storage.
+    ///
+    /// # Example
+    /// ```
+    /// use gmatlib::Matrix;
+    ///
+    /// let a: Matrix<i32> = Matrix::from_vec(
+    ///     2,
+    ///     vec![1, 2,
+    ///          3, 4,
+    ///          5, 6]
+    /// ).unwrap();
+    ///
+    /// let t = a.as_view().transpose();
+    ///
+    /// assert_eq!(t.get_rows(), 2);
+    /// assert_eq!(t.get_cols(), 3);
+    /// assert_eq!(t[(0, 2)], 5);
+    /// ```
+    pub fn transpose(&self) -> MatrixView<'a, T>
+    {
+        MatrixView
+        {
+            vals: self.vals,
+            offset: self.offset,
+            rows: self.cols,
+            cols: self.rows,
+            row_stride: self.col_stride,
+            col_stride: self.row_stride,
+        }
+    }
+
+    /// Returns a narrower view of the rows in a range from `r1` to `r2`
+    /// and columns in a range from `c1` to `c2` without copying.
+    ///
+    /// # Panics
+    /// This operation will panic under the same conditions as
+    /// `Matrix::subset`.
+    pub fn subset(&self, r1: usize, c1: usize, r2: usize, c2: usize) -> MatrixView<'a, T>
+    {
+        if r1 > r2 || c1 > c2 || r2 >= self.rows || c2 >= self.cols
+        {
+            panic!("cannot take subset view: indices were backwards or out of bounds for a {} x {} view", self.rows, self.cols)
+        }
+
+        MatrixView
+        {
+            vals: self.vals,
+            offset: self.offset + r1 * self.row_stride + c1 * self.col_stride,
+            rows: r2 - r1 + 1,
+            cols: c2 - c1 + 1,
+            row_stride: self.row_stride,
+            col_stride: self.col_stride,
+        }
+    }
+
+    /// Returns an iterator over the elements visible through the view in
+    /// left-to-right, top-to-bottom order.
+    pub fn iter(&self) -> impl Iterator<Item = &'a T> + '_
+    {
+        (0..self.rows).flat_map(move |i| {
+            (0..self.cols).map(move |j| {
+                &self.vals[self.offset + i * self.row_stride + j * self.col_stride]
+            })
+        })
+    }
+
+    /// Copies the values visible through the view into a freshly-owned
+    /// `Matrix<T>`. This is the only `MatrixView<'_, T>` operation that
+    /// allocates.
+    pub fn to_matrix(&self) -> Matrix<T>
+    {
+        let mut a = Matrix::new(self.rows, self.cols);
+        for i in 0..self.rows
+        {
+            for j in 0..self.cols
+            {
+                a[(i, j)] = self[(i, j)];
+            }
+        }
+        a
+    }
+
+    /// Creates a new `Matrix<T>` with the columns of `a` appended to the
+    /// columns of `self`, exactly like `Matrix::augment_with` but reading
+    /// both operands through views.
+    pub fn augment_with(&self, a: &MatrixView<'_, T>) -> Result<Matrix<T>>
+    {
+        if a.rows != self.rows
+        {
+            return Err(MatrixAugmentationError { a: self.rows, b: a.rows }.into())
+        }
+
+        let mut b: Matrix<T> = Matrix::new(self.rows, self.cols + a.cols);
+
+        for i in 0..self.rows
+        {
+            for j in 0..self.cols
+            {
+                b[(i, j)] = self[(i, j)];
+            }
+            for j in 0..a.cols
+            {
+                b[(i, j + self.cols)] = a[(i, j)];
+            }
+        }
+
+        Ok(b)
+    }
+
+    /// Returns the matrix multiplication product of two views as an owned
+    /// `Matrix<T>`. This operation will fail if the operands are not
+    /// suitable for matrix multiplication.
+    pub fn multiply_view(&self, a: &MatrixView<'_, T>) -> Result<Matrix<T>>
+    {
+        if self.cols != a.rows
+        {
+            return Err(MatrixMultiplicationError.into())
+        }
+
+        let mut result = Matrix::new(self.rows, a.cols);
+        for i in 0..self.rows
+        {
+            for j in 0..a.cols
+            {
+                for x in 0..self.cols
+                {
+                    result[(i, j)] += self[(i, x)] * a[(x, j)];
+                }
+            }
+        }
+
+        Ok(result)
+    }
+}
+
+impl <T> Index<(usize, usize)> for MatrixView<'_, T>
+where T: Element<T>
+{
+    type Output = T;
+
+    #[inline]
+    fn index(&self, index: (usize, usize)) -> &T
+    {
+        if index.0 >= self.rows || index.1 >= self.cols
+        {
+            panic!("index out of bounds: the view has {} rows and {} cols but the index was [({}, {})]", self.rows, self.cols, index.0, index.1)
+        }
+        &self.vals[self.offset + index.0 * self.row_stride + index.1 * self.col_stride]
+    }
+}
+
+impl <T> PartialEq for MatrixView<'_, T>
+where T: Element<T>
+{
+    fn eq(&self, other: &Self) -> bool
+    {
+        self.rows == other.rows &&
+        self.cols == other.cols &&
+        self.iter().eq(other.iter())
+    }
+}
+
+impl <T> Add for &MatrixView<'_, T>
+where T: Element<T>
+{
+    type Output = Matrix<T>;
+
+    /// Performs element-wise addition between all elements of two views,
+    /// producing an owned `Matrix<T>`.
+    ///
+    /// # Panics
+    /// This method will panic if the views are of different sizes.
+    fn add(self, rhs: Self) -> Self::Output
+    {
+        if self.rows != rhs.rows ||
+           self.cols != rhs.cols
+        {
+            panic!("cannot add elements of matrices with different sizes")
+        }
+
+        let mut ret_val = self.to_matrix();
+        for i in 0..self.rows
+        {
+            for j in 0..self.cols
+            {
+                ret_val[(i, j)] += rhs[(i, j)];
+            }
+        }
+        ret_val
+    }
+}
+
+impl <T> Sub for &MatrixView<'_, T>
+where T: Element<T>
+{
+    type Output = Matrix<T>;
+
+    /// Performs element-wise subtraction between all elements of two views,
+    /// producing an owned `Matrix<T>`.
+    ///
+    /// # Panics
+    /// This method will panic if the views are of different sizes.
+    fn sub(self, rhs: Self) -> Self::Output
+    {
+        if self.rows != rhs.rows ||
+           self.cols != rhs.cols
+        {
+            panic!("cannot subtract elements of matrices with different sizes")
+        }
+
+        let mut ret_val = self.to_matrix();
+        for i in 0..self.rows
+        {
+            for j in 0..self.cols
+            {
+                ret_val[(i, j)] -= rhs[(i, j)];
+            }
+        }
+        ret_val
+    }
+}
+
+impl <T> Mul for &MatrixView<'_, T>
+where T: Element<T>
+{
+    type Output = Matrix<T>;
+
+    /// Shorthand for `MatrixView::multiply_view`.
+    ///
+    /// # Panics
+    /// This operation will panic if the operands are not suitable for
+    /// matrix multiplication.
+    fn mul(self, rhs: Self) -> Self::Output
+    {
+        self.multiply_view(rhs).unwrap()
+    }
+}
@@ -136,4 +136,314 @@ fn ensure_inplace_transpose_method_works_on_case_not_in_doctest()
              2, 5,
              3, 6]
     );
-}
\ No newline at end of file
+}
+#[test]
+fn ensure_lu_decomposition_solves_system_with_zero_leading_pivot()
+{
+    use gmatlib::lu::LuDecomposition;
+
+    // Gauss-Jordan without pivoting fails on this matrix outright
+    let a = Matrix::from_vec(
+        3,
+        vec![0.0, 2.0, 1.0,
+             1.0, 1.0, 1.0,
+             2.0, 0.0, 3.0]
+    ).unwrap();
+
+    let lu = LuDecomposition::try_from_matrix(a.clone()).unwrap();
+
+    let b = Matrix::from_col_vec(vec![4.0, 6.0, 5.0]);
+    let x = lu.solve(&b).unwrap();
+
+    // Check the solution by substituting it back into Ax = b
+    let check: Vec<f64> = a.multiply_matrix(&x).unwrap().into();
+    let b_vec: Vec<f64> = b.into();
+
+    for i in 0..3
+    {
+        assert!((check[i] - b_vec[i]).abs() < 1e-12);
+    }
+}
+
+#[test]
+fn ensure_lu_decomposition_solves_many_right_hand_sides()
+{
+    use gmatlib::lu::LuDecomposition;
+
+    let a = Matrix::from_vec(
+        2,
+        vec![ 3.0, 1.0,
+             -1.0, 2.0]
+    ).unwrap();
+
+    let lu = LuDecomposition::try_from_matrix(a).unwrap();
+
+    // Factor once, solve twice:
+    let rhs = Matrix::from_vec(
+        2,
+        vec![5.0,  7.0,
+             0.0, -7.0]
+    ).unwrap();
+
+    let x: Vec<f64> = lu.solve(&rhs).unwrap().into();
+
+    let check = vec![10.0/7.0,  3.0,
+                      5.0/7.0, -2.0];
+
+    for i in 0..4
+    {
+        assert!((x[i] - check[i]).abs() < 1e-12);
+    }
+}
+
+#[test]
+fn ensure_lu_decomposition_rejects_singular_matrix()
+{
+    use gmatlib::lu::LuDecomposition;
+
+    let a = Matrix::from_vec(
+        2,
+        vec![1.0, 2.0,
+             2.0, 4.0]
+    ).unwrap();
+
+    assert!(LuDecomposition::try_from_matrix(a).is_err());
+}
+
+#[test]
+fn ensure_sparse_matrix_round_trips_through_dense_and_multiplies()
+{
+    use gmatlib::sparse::SparseMatrix;
+
+    let a = Matrix::from_vec(
+        3,
+        vec![2.0, 0.0, 1.0,
+             0.0, 3.0, 0.0,
+             0.0, 0.0, 4.0]
+    ).unwrap();
+
+    let s = SparseMatrix::from_dense(&a);
+    assert_eq!(s.nnz(), 4);
+    assert_eq!(s.to_dense(), a);
+
+    let x = Matrix::from_col_vec(vec![1.0, 2.0, 3.0]);
+    let dense_product: Vec<f64> = a.multiply_matrix(&x).unwrap().into();
+    let sparse_product: Vec<f64> = s.multiply_col_vec(&x).unwrap().into();
+
+    assert_eq!(dense_product, sparse_product);
+}
+
+#[test]
+fn ensure_sparse_matrix_sums_duplicate_triplets()
+{
+    use gmatlib::sparse::SparseMatrix;
+
+    let s = SparseMatrix::from_triplets(
+        2, 2,
+        vec![(0, 0, 1.0), (0, 0, 2.0), (1, 1, 1.0)]
+    ).unwrap();
+
+    assert_eq!(s.nnz(), 2);
+    assert_eq!(s.get(0, 0), 3.0);
+}
+
+#[test]
+fn ensure_sparse_gauss_seidel_solves_diagonally_dominant_system()
+{
+    use gmatlib::sparse::SparseMatrix;
+
+    // A 1-D chain like the nodal systems this type is built for
+    let n = 50;
+    let mut triplets = vec![];
+    for i in 0..n
+    {
+        triplets.push((i, i, 4.0));
+        if i > 0
+        {
+            triplets.push((i, i - 1, -1.0));
+        }
+        if i < n - 1
+        {
+            triplets.push((i, i + 1, -1.0));
+        }
+    }
+    let a = SparseMatrix::from_triplets(n, n, triplets).unwrap();
+
+    let b = Matrix::from_col_vec(vec![1.0; n]);
+    let x = a.try_solve_gauss_seidel(&b, 1e-12, 1000).unwrap();
+
+    // Check the solution by substituting it back into Ax = b
+    let check: Vec<f64> = a.multiply_col_vec(&x).unwrap().into();
+    for i in 0..n
+    {
+        assert!((check[i] - 1.0).abs() < 1e-9);
+    }
+}
+
+#[test]
+fn ensure_simd_row_kernels_match_scalar_results()
+{
+    // Long enough rows to exercise both the vector lanes and the
+    // scalar remainder of the AVX kernels
+    let cols = 37;
+    let mut a: Matrix<f64> = Matrix::from_vec(
+        cols,
+        (0..cols * 2).map(|i| i as f64 * 0.5).collect()
+    ).unwrap();
+
+    let mut check = vec![0.0; cols];
+    for i in 0..cols
+    {
+        check[i] = (i as f64 * 0.5) + 2.5 * ((cols + i) as f64 * 0.5);
+    }
+
+    a.inplace_scaled_row_add(0, 1, 2.5);
+    for i in 0..cols
+    {
+        assert!((a[(0, i)] - check[i]).abs() < 1e-12);
+    }
+
+    a.inplace_row_scale(1, 3.0);
+    for i in 0..cols
+    {
+        assert!((a[(1, i)] - 3.0 * ((cols + i) as f64 * 0.5)).abs() < 1e-12);
+    }
+}
+
+#[test]
+fn ensure_scaled_row_add_handles_same_row_for_both_operands()
+{
+    let mut a: Matrix<f64> = Matrix::from_vec(
+        3,
+        vec![1.0, 2.0, 3.0,
+             4.0, 5.0, 6.0]
+    ).unwrap();
+
+    // r1 == r2 degenerates to scaling the row by (1 + scalar)
+    a.inplace_scaled_row_add(0, 0, 1.0);
+
+    let a_vec: Vec<f64> = a.into();
+    assert_eq!(
+        a_vec,
+        vec![2.0, 4.0, 6.0,
+             4.0, 5.0, 6.0]
+    );
+}
+
+#[test]
+fn ensure_blocked_multiplication_matches_plain_multiplication()
+{
+    use rand::{Rng, SeedableRng};
+    use rand::rngs::StdRng;
+
+    let mut rng = StdRng::seed_from_u64(42);
+    let n = 150; // larger than one tile, not a multiple of the tile size
+
+    let a: Matrix<f64> = Matrix::from_vec(
+        n,
+        (0..n * n).map(|_| rng.gen_range(-1.0..1.0)).collect()
+    ).unwrap();
+    let b: Matrix<f64> = Matrix::from_vec(
+        n,
+        (0..n * n).map(|_| rng.gen_range(-1.0..1.0)).collect()
+    ).unwrap();
+
+    let plain: Vec<f64> = a.multiply_matrix(&b).unwrap().into();
+    let blocked: Vec<f64> = a.multiply_matrix_blocked(&b, 4).unwrap().into();
+
+    for i in 0..n * n
+    {
+        assert!((plain[i] - blocked[i]).abs() < 1e-12);
+    }
+}
+
+#[test]
+fn ensure_matrix_view_subset_and_transpose_match_owned_methods()
+{
+    let a: Matrix<i32> = Matrix::from_vec(
+        4,
+        vec![ 1,  2,  3,  4,
+              5,  6,  7,  8,
+              9, 10, 11, 12]
+    ).unwrap();
+
+    // Zero-copy subset matches the copying one
+    let v = a.subset_view(1, 1, 2, 3);
+    assert_eq!(v.to_matrix(), a.subset(1, 1, 2, 3));
+
+    // Lazily-transposed view matches the copying transpose
+    let t = a.as_view().transpose();
+    assert_eq!(t.to_matrix(), a.transpose());
+
+    // Views compose: transposing a subset view reads the right values
+    assert_eq!(v.transpose()[(2, 1)], a[(2, 3)]);
+}
+
+#[test]
+fn ensure_matrix_view_arithmetic_matches_owned_arithmetic()
+{
+    let a: Matrix<i32> = Matrix::from_vec(
+        2,
+        vec![1, 2,
+             3, 4]
+    ).unwrap();
+    let b: Matrix<i32> = Matrix::from_vec(
+        2,
+        vec![5, 6,
+             7, 8]
+    ).unwrap();
+
+    assert_eq!(&a.as_view() + &b.as_view(), a.clone() + b.clone());
+    assert_eq!(&a.as_view() - &b.as_view(), a.clone() - b.clone());
+    assert_eq!(&a.as_view() * &b.as_view(), a.multiply_matrix(&b).unwrap());
+
+    // ...and augmentation through views matches the owned method
+    assert_eq!(
+        a.as_view().augment_with(&b.as_view()).unwrap(),
+        a.augment_with(&b).unwrap()
+    );
+}
+
+#[test]
+fn ensure_inline_and_heap_backed_matrices_behave_identically()
+{
+    // 3x1 column vectors fit in the inline buffer...
+    let small_a: Matrix<f64> = Matrix::from_col_vec(vec![1.0, 2.0, 3.0]);
+    let small_b = small_a.clone() + Matrix::from_col_vec(vec![3.0, 2.0, 1.0]);
+    assert_eq!(small_b, Matrix::from_col_vec(vec![4.0, 4.0, 4.0]));
+
+    // ...5x5 matrices spill to the heap; both must behave the same
+    let mut big: Matrix<f64> = Matrix::new_identity(5);
+    big.try_inplace_invert().unwrap();
+    assert_eq!(big, Matrix::new_identity(5));
+
+    // Equality and conversion are storage-agnostic at the boundary
+    let boundary: Matrix<f64> = Matrix::new(4, 4);
+    let boundary_vec: Vec<f64> = boundary.clone().into();
+    assert_eq!(boundary, Matrix::from_vec(4, boundary_vec).unwrap());
+}
+
+#[test]
+fn ensure_fused_kernels_match_operator_results()
+{
+    let a: Matrix<f64> = Matrix::from_vec(
+        2,
+        vec![1.0, 2.0,
+             3.0, 4.0]
+    ).unwrap();
+    let x = Matrix::from_col_vec(vec![5.0, 6.0]);
+
+    // gemv_into writes the same product the allocating operator builds
+    let mut out = Matrix::new(2, 1);
+    a.gemv_into(&x, &mut out).unwrap();
+    assert_eq!(out, &a * &x);
+
+    // ...and shape mismatches are reported rather than panicking
+    assert!(a.gemv_into(&a, &mut out).is_err());
+
+    // axpy_into matches scaling and adding with the operators
+    let mut b = a.clone();
+    b.axpy_into(2.0, &a).unwrap();
+    assert_eq!(b, &a + &(&a * 2.0));
+    assert!(b.axpy_into(1.0, &x).is_err());
+}
@@ -0,0 +1,104 @@
+//! End-to-end benchmarks for the nodal analysis solver: model building,
+//! engine construction, and the sparse Newton iteration behind `run_study`.
+//!
+//! Each workload builds a resistor ladder of the given size and solves it
+//! the way a user would, reporting wall time, peak heap, and allocation
+//! counts from a counting global allocator alongside the solver telemetry
+//! counters from `geqslib::telemetry`. Run with `cargo bench -p neapolitan`.
+
+use std::alloc::{GlobalAlloc, Layout, System};
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::time::Instant;
+
+use geqslib::telemetry::{reset_solver_telemetry, solver_telemetry};
+use neapolitan::NodalAnalysisStudyBuilder;
+use neapolitan::ssdc_circuits::{RESISTOR, SSDC_CIRCUIT, VOLTAGE_SOURCE};
+
+/// The ladder sizes every workload sweeps over, in nodes.
+const _SIZES_: [usize; 3] = [50, 200, 500];
+
+/// A `System` wrapper that tallies every allocation so the benchmarks can
+/// report peak heap and allocation counts alongside wall time.
+struct CountingAllocator;
+
+static ALLOCATIONS: AtomicUsize = AtomicUsize::new(0);
+static LIVE_BYTES: AtomicUsize = AtomicUsize::new(0);
+static PEAK_BYTES: AtomicUsize = AtomicUsize::new(0);
+
+unsafe impl GlobalAlloc for CountingAllocator
+{
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8
+    {
+        ALLOCATIONS.fetch_add(1, Ordering::Relaxed);
+        let live = LIVE_BYTES.fetch_add(layout.size(), Ordering::Relaxed) + layout.size();
+        PEAK_BYTES.fetch_max(live, Ordering::Relaxed);
+        System.alloc(layout)
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout)
+    {
+        LIVE_BYTES.fetch_sub(layout.size(), Ordering::Relaxed);
+        System.dealloc(ptr, layout)
+    }
+}
+
+#[global_allocator]
+static ALLOC: CountingAllocator = CountingAllocator;
+
+/// Zeroes the allocation counters; peak restarts from the bytes currently live.
+fn reset_alloc_counters()
+{
+    ALLOCATIONS.store(0, Ordering::Relaxed);
+    PEAK_BYTES.store(LIVE_BYTES.load(Ordering::Relaxed), Ordering::Relaxed);
+}
+
+/// Builds and solves a `nodes`-node series resistor ladder: a 3V source
+/// into a chain of 1-ohm resistors closing back to ground. Every interior
+/// node is unlocked, so the jacobian grows with the ladder.
+fn run_ladder(nodes: usize)
+{
+    reset_alloc_counters();
+    reset_solver_telemetry();
+
+    let start = Instant::now();
+    let mut builder = NodalAnalysisStudyBuilder::new(SSDC_CIRCUIT.to_string(), None)
+        .expect("failed to create model builder object")
+        .add_nodes(nodes)
+        .configure_node(0, vec![0.0], true, None)
+        .add_element(VOLTAGE_SOURCE, 0, 1, vec![3.0])
+        .expect("failed to make voltage source");
+
+    for i in 1..nodes - 1
+    {
+        builder = builder.add_element(RESISTOR, i, i + 1, vec![1.0])
+            .expect("failed to make resistor");
+    }
+    builder = builder.add_element(RESISTOR, nodes - 1, 0, vec![1.0])
+        .expect("failed to make closing resistor");
+
+    let soln = builder.run_study().expect("benchmark ladder failed to solve");
+    let elapsed = start.elapsed();
+
+    let stats = solver_telemetry();
+    let rep = serde_json::to_value(&soln).expect("failed to serialize solution");
+    println!(
+        "network_solve/{nodes}_nodes: {:>6} elements in {:>9.3?} | peak heap {:>9} B, {:>8} allocs | {} iters, {} residual evals, {} jacobian builds, {} solves, final residual {:.3e}",
+        rep["elements"].as_object().map(|m| m.len()).unwrap_or(0),
+        elapsed,
+        PEAK_BYTES.load(Ordering::Relaxed),
+        ALLOCATIONS.load(Ordering::Relaxed),
+        stats.iterations,
+        stats.residual_evals,
+        stats.jacobian_builds,
+        stats.jacobian_solves,
+        stats.final_residual,
+    );
+}
+
+fn main()
+{
+    for nodes in _SIZES_
+    {
+        run_ladder(nodes);
+    }
+}
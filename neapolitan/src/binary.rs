@@ -0,0 +1,307 @@
+//! A compact binary serialization of `NodalAnalysisModel`.
+//!
+//! # Concept:
+//! JSON stays the interchange format, but re-parsing megabytes of text with
+//! one `Vec<f64>` allocation per element makes loading large pre-generated
+//! networks slower than solving them. The binary format stores fixed-width
+//! little-endian records for elements and node configurations, one
+//! deduplicated string table for element type names and metadata keys, and
+//! one length-prefixed payload holding every gain and potential value.
+//! `load_model` memory-maps the file and decodes the records in place — no
+//! intermediate text, no per-record parsing state.
+
+use std::collections::HashMap;
+use std::fs::File;
+use std::path::Path;
+
+use memmap2::Mmap;
+
+use crate::errors::BinaryModelFormatError;
+use crate::modelling::{NodalAnalysisElement, NodalAnalysisModel, NodalMetadata};
+
+const MAGIC: &[u8; 4] = b"NAPM";
+const VERSION: u32 = 1;
+
+/// Flag bits used in configuration records
+const FLAG_LOCKED: u32 = 1;
+const FLAG_HAS_METADATA: u32 = 2;
+
+/// Accumulates the deduplicated string table while encoding.
+struct StringTable
+{
+    strings: Vec<String>,
+    index_of: HashMap<String, u32>,
+}
+impl StringTable
+{
+    fn new() -> StringTable
+    {
+        StringTable { strings: vec![], index_of: HashMap::new() }
+    }
+
+    fn intern(&mut self, s: &str) -> u32
+    {
+        if let Some(&i) = self.index_of.get(s)
+        {
+            return i;
+        }
+        let i = self.strings.len() as u32;
+        self.strings.push(s.to_owned());
+        self.index_of.insert(s.to_owned(), i);
+        i
+    }
+}
+
+fn push_u32(buf: &mut Vec<u8>, x: u32)
+{
+    buf.extend_from_slice(&x.to_le_bytes());
+}
+
+fn push_f64(buf: &mut Vec<u8>, x: f64)
+{
+    buf.extend_from_slice(&x.to_le_bytes());
+}
+
+/// Encodes a model into the binary format.
+pub (in crate) fn encode_model(model: &NodalAnalysisModel) -> anyhow::Result<Vec<u8>>
+{
+    if model.nodes > u32::MAX as usize
+    {
+        return Err(BinaryModelFormatError::TooManyNodes.into());
+    }
+
+    let mut strings = StringTable::new();
+    let mut payload: Vec<f64> = vec![];
+    let mut meta_pairs: Vec<(u32, f64)> = vec![];
+
+    let model_type_idx = strings.intern(&model.model_type);
+
+    // Element records: type_idx, input, output, gain offset + length
+    let mut element_records: Vec<u8> = vec![];
+    for element in &model.elements
+    {
+        push_u32(&mut element_records, strings.intern(&element.element_type));
+        push_u32(&mut element_records, element.input as u32);
+        push_u32(&mut element_records, element.output as u32);
+        push_u32(&mut element_records, payload.len() as u32);
+        push_u32(&mut element_records, element.gain.len() as u32);
+        payload.extend_from_slice(&element.gain);
+    }
+
+    // Configuration records: node, flags, potential + metadata spans
+    let mut config_records: Vec<u8> = vec![];
+    for (&node, metadata) in &model.configuration
+    {
+        let mut flags = 0;
+        if metadata.is_locked
+        {
+            flags |= FLAG_LOCKED;
+        }
+
+        push_u32(&mut config_records, node as u32);
+        let meta_off = meta_pairs.len() as u32;
+        let mut meta_len = 0;
+        if let Some(map) = &metadata.metadata
+        {
+            flags |= FLAG_HAS_METADATA;
+            for (key, &val) in map
+            {
+                meta_pairs.push((strings.intern(key), val));
+                meta_len += 1;
+            }
+        }
+        push_u32(&mut config_records, flags);
+        push_u32(&mut config_records, payload.len() as u32);
+        push_u32(&mut config_records, metadata.potential.len() as u32);
+        push_u32(&mut config_records, meta_off);
+        push_u32(&mut config_records, meta_len);
+        payload.extend_from_slice(&metadata.potential);
+    }
+
+    // Assemble the sections in read order
+    let mut buf = vec![];
+    buf.extend_from_slice(MAGIC);
+    push_u32(&mut buf, VERSION);
+    push_u32(&mut buf, model.nodes as u32);
+    push_u32(&mut buf, model_type_idx);
+
+    push_u32(&mut buf, strings.strings.len() as u32);
+    for s in &strings.strings
+    {
+        push_u32(&mut buf, s.len() as u32);
+        buf.extend_from_slice(s.as_bytes());
+    }
+
+    push_u32(&mut buf, payload.len() as u32);
+    for &x in &payload
+    {
+        push_f64(&mut buf, x);
+    }
+
+    push_u32(&mut buf, meta_pairs.len() as u32);
+    for &(key_idx, val) in &meta_pairs
+    {
+        push_u32(&mut buf, key_idx);
+        push_f64(&mut buf, val);
+    }
+
+    push_u32(&mut buf, model.elements.len() as u32);
+    buf.extend_from_slice(&element_records);
+
+    push_u32(&mut buf, model.configuration.len() as u32);
+    buf.extend_from_slice(&config_records);
+
+    Ok(buf)
+}
+
+/// A bounds-checked reading position over the raw bytes.
+struct Cursor<'a>
+{
+    bytes: &'a [u8],
+    pos: usize,
+}
+impl<'a> Cursor<'a>
+{
+    fn take(&mut self, n: usize) -> anyhow::Result<&'a [u8]>
+    {
+        if self.pos + n > self.bytes.len()
+        {
+            return Err(BinaryModelFormatError::UnexpectedEndOfData.into());
+        }
+        let slice = &self.bytes[self.pos..self.pos + n];
+        self.pos += n;
+        Ok(slice)
+    }
+
+    fn read_u32(&mut self) -> anyhow::Result<u32>
+    {
+        Ok(u32::from_le_bytes(self.take(4)?.try_into().unwrap()))
+    }
+
+    fn read_f64(&mut self) -> anyhow::Result<f64>
+    {
+        Ok(f64::from_le_bytes(self.take(8)?.try_into().unwrap()))
+    }
+}
+
+/// Decodes a model from the binary format produced by `encode_model`.
+pub (in crate) fn decode_model(bytes: &[u8]) -> anyhow::Result<NodalAnalysisModel>
+{
+    let mut cursor = Cursor { bytes, pos: 0 };
+
+    if cursor.take(4)? != MAGIC
+    {
+        return Err(BinaryModelFormatError::BadMagicNumber.into());
+    }
+    if cursor.read_u32()? != VERSION
+    {
+        return Err(BinaryModelFormatError::UnsupportedVersion.into());
+    }
+    let nodes = cursor.read_u32()? as usize;
+    let model_type_idx = cursor.read_u32()? as usize;
+
+    let string_count = cursor.read_u32()? as usize;
+    let mut strings = Vec::with_capacity(string_count);
+    for _ in 0..string_count
+    {
+        let len = cursor.read_u32()? as usize;
+        strings.push(
+            std::str::from_utf8(cursor.take(len)?)
+                .map_err(|_| BinaryModelFormatError::MalformedString)?
+                .to_owned()
+        );
+    }
+    let string_at = |i: usize| strings.get(i)
+        .cloned()
+        .ok_or(BinaryModelFormatError::UnexpectedEndOfData);
+
+    let payload_len = cursor.read_u32()? as usize;
+    let mut payload = Vec::with_capacity(payload_len);
+    for _ in 0..payload_len
+    {
+        payload.push(cursor.read_f64()?);
+    }
+    let payload_at = |off: usize, len: usize| payload.get(off..off + len)
+        .map(|s| s.to_vec())
+        .ok_or(BinaryModelFormatError::UnexpectedEndOfData);
+
+    let meta_count = cursor.read_u32()? as usize;
+    let mut meta_pairs = Vec::with_capacity(meta_count);
+    for _ in 0..meta_count
+    {
+        let key_idx = cursor.read_u32()? as usize;
+        meta_pairs.push((key_idx, cursor.read_f64()?));
+    }
+
+    let element_count = cursor.read_u32()? as usize;
+    let mut elements = Vec::with_capacity(element_count);
+    for _ in 0..element_count
+    {
+        let type_idx = cursor.read_u32()? as usize;
+        let input = cursor.read_u32()? as usize;
+        let output = cursor.read_u32()? as usize;
+        let gain_off = cursor.read_u32()? as usize;
+        let gain_len = cursor.read_u32()? as usize;
+
+        elements.push(NodalAnalysisElement
+        {
+            element_type: string_at(type_idx)?,
+            input,
+            output,
+            gain: payload_at(gain_off, gain_len)?,
+        });
+    }
+
+    let config_count = cursor.read_u32()? as usize;
+    let mut configuration = HashMap::with_capacity(config_count);
+    for _ in 0..config_count
+    {
+        let node = cursor.read_u32()? as usize;
+        let flags = cursor.read_u32()?;
+        let pot_off = cursor.read_u32()? as usize;
+        let pot_len = cursor.read_u32()? as usize;
+        let meta_off = cursor.read_u32()? as usize;
+        let meta_len = cursor.read_u32()? as usize;
+
+        let metadata = if flags & FLAG_HAS_METADATA != 0
+        {
+            let pairs = meta_pairs.get(meta_off..meta_off + meta_len)
+                .ok_or(BinaryModelFormatError::UnexpectedEndOfData)?;
+            let mut map = HashMap::with_capacity(pairs.len());
+            for &(key_idx, val) in pairs
+            {
+                map.insert(string_at(key_idx)?, val);
+            }
+            Some(map)
+        }
+        else
+        {
+            None
+        };
+
+        configuration.insert(node, NodalMetadata
+        {
+            potential: payload_at(pot_off, pot_len)?,
+            is_locked: flags & FLAG_LOCKED != 0,
+            metadata,
+        });
+    }
+
+    Ok(NodalAnalysisModel
+    {
+        model_type: string_at(model_type_idx)?,
+        nodes,
+        configuration,
+        elements,
+    })
+}
+
+/// Loads a binary model file by memory-mapping it and decoding the mapped
+/// bytes in place, avoiding both a read-to-buffer copy and any text parsing.
+pub fn load_model(path: impl AsRef<Path>) -> anyhow::Result<NodalAnalysisModel>
+{
+    let file = File::open(path)?;
+    // Safety: the mapping is read-only and dropped before this call returns
+    let map = unsafe { Mmap::map(&file)? };
+    decode_model(&map)
+}
@@ -19,6 +19,8 @@ pub enum FluxCalculationError
 {
     #[error("failed to access nodes during flux calculation because they were already dropped.")]
     NodeRefsAlreadyDropped,
+    #[error("elements that observe an adjacent flux balance form a cycle that cannot be resolved.")]
+    ObserverCycle,
 }
 
 #[derive(Debug, Error)]
@@ -34,6 +36,21 @@ pub enum NodalAnalysisConfigurationError
     ConfigurationNameCollision,
 }
 
+#[derive(Debug, Error)]
+pub enum BinaryModelFormatError
+{
+    #[error("the data is not a binary nodal analysis model (bad magic number)")]
+    BadMagicNumber,
+    #[error("the binary model was written by an unsupported format version")]
+    UnsupportedVersion,
+    #[error("the binary model data ended earlier than its records claim")]
+    UnexpectedEndOfData,
+    #[error("the binary model contains a string that is not valid utf-8")]
+    MalformedString,
+    #[error("the model has more nodes than the binary format can address")]
+    TooManyNodes,
+}
+
 #[derive(Debug, Error)]
 pub enum NodalAnalysisModellingError
 {
@@ -41,4 +58,6 @@ pub enum NodalAnalysisModellingError
     NodeDoesNotExist,
     #[error("could not find desired model type in the given or default configurators")]
     ModelTypeNotFound,
+    #[error("cannot update an element gain on a model that uses custom flux calculations")]
+    GainUpdateUnsupported,
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 pub mod modelling;
-/// Contains error types for the various errors that 
+/// Contains a compact binary serialization of nodal analysis models and a
+/// memory-mapped loader for it.
+pub mod binary;
+/// Contains error types for the various errors that
 /// may be thrown in the `neapolitan` crate.
 pub mod errors;
 /// Contains functions used by the nodal analysis 
@@ -10,7 +13,7 @@ pub mod flux_formulas;
 pub mod ssdc_circuits;
 
 // Standard modules
-use std::collections::HashMap;
+use std::collections::{HashMap, HashSet};
 use std::fmt::Debug;
 use std::rc::{Rc, Weak};
 use std::cell::RefCell;
@@ -19,7 +22,10 @@ use anyhow::Ok;
 use modelling::{NodalAnalysisElement, NodalAnalysisModel, NodalMetadata};
 // 3rd party modules
 use serde::Serialize;
-use geqslib::newton::multivariate_newton_raphson;
+use geqslib::errors::NewtonRaphsonSolverError;
+use geqslib::telemetry;
+use gmatlib::lu::LuDecomposition;
+use gmatlib::sparse::SparseMatrix;
 
 /// This is a re-export of a `gmatlib::Matrix<T>`, a type for representing numerical 
 /// matrices and vectors and operating on them in a more math-oriented way.
@@ -35,6 +41,7 @@ pub type Matrix<T> = gmatlib::Matrix<T>;
 
 // Local modules
 use errors::{DroppedNodeError, NodalAnalysisConfigurationError, NodalAnalysisModellingError};
+use modelling::arena::{ArenaModel, ArenaResidualEngine};
 use modelling::element::{ElementConstructor, GenericElement};
 use modelling::node::GenericNode;
 use serde_json::to_string_pretty;
@@ -63,6 +70,202 @@ struct ComponentIndex
     component: u32,
 }
 
+const _DX_: f64 = 0.001;
+
+/// Evaluates a model's residuals against a single flat state vector.
+///
+/// # Concept:
+/// The solver only cares about the unlocked nodal potential components, so
+/// the engine numbers them once and keeps their values in one contiguous
+/// `Vec<f64>`. Writing a perturbed guess touches exactly one component, and
+/// one call to `residuals` produces the flux discrepancy of every unlocked
+/// node in a single pass over the network — each node's discrepancy is
+/// computed once no matter how many components it contributes.
+struct NodalResidualEngine
+{
+    nodes: Vec<Rc<RefCell<GenericNode>>>,
+    unlocked: Vec<ComponentIndex>,
+    /// For each state-vector entry, the (sorted) state-vector entries whose
+    /// residuals are structurally coupled to it through the element network.
+    coupled_rows: Vec<Vec<usize>>,
+}
+impl NodalResidualEngine
+{
+    /// Creates an engine for the given nodes. `incidence` lists, for each
+    /// node, the nodes whose flux discrepancies its potential can influence
+    /// (including itself); it is extracted from the element list at build
+    /// time so the jacobian only ever touches structurally nonzero partials.
+    fn new(nodes: Vec<Rc<RefCell<GenericNode>>>, incidence: &[Vec<usize>]) -> NodalResidualEngine
+    {
+        let mut unlocked = vec![];
+        let mut rows_of_node = vec![vec![]; nodes.len()];
+        for (node_idx, node) in nodes.iter().enumerate()
+        {
+            let node = node.borrow();
+            if node.is_locked
+            {
+                continue;
+            }
+            for comp_idx in 0..node.potential.get_rows()
+            {
+                rows_of_node[node_idx].push(unlocked.len());
+                unlocked.push(ComponentIndex
+                {
+                    node: node_idx as u32,
+                    component: comp_idx as u32,
+                });
+            }
+        }
+
+        // A column for node n couples to every unlocked component of every
+        // node that n's potential can reach through an element
+        let coupled_rows = unlocked.iter()
+            .map(|idx| incidence[idx.node as usize].iter()
+                .flat_map(|&m| rows_of_node[m].iter().copied())
+                .collect()
+            )
+            .collect();
+
+        NodalResidualEngine { nodes, unlocked, coupled_rows }
+    }
+
+    /// Gathers the unlocked nodal potential components into a flat state vector.
+    fn state(&self) -> anyhow::Result<Vec<f64>>
+    {
+        let mut x = Vec::with_capacity(self.unlocked.len());
+        for &ComponentIndex { node, component } in &self.unlocked
+        {
+            x.push(
+                self.nodes[node as usize]
+                    .try_borrow()?
+                    .potential[(component as usize, 0)]
+            );
+        }
+        Ok(x)
+    }
+
+    /// Writes a single component of the flat state vector back into its node.
+    fn write_component(&self, i: usize, val: f64) -> anyhow::Result<()>
+    {
+        let ComponentIndex { node, component } = self.unlocked[i];
+        self.nodes[node as usize]
+            .try_borrow_mut()?
+            .potential[(component as usize, 0)] = val;
+        Ok(())
+    }
+
+    /// Evaluates every residual in one pass over the unlocked nodes. Each
+    /// node's flux discrepancy is computed once and shared by all of the
+    /// components it contributes to the state vector.
+    fn residuals(&self, y: &mut [f64]) -> anyhow::Result<()>
+    {
+        let mut i = 0;
+        while i < self.unlocked.len()
+        {
+            let node_idx = self.unlocked[i].node;
+            let discrepancy = self.nodes[node_idx as usize]
+                .try_borrow()?
+                .get_flux_discrepancy()?;
+
+            while i < self.unlocked.len() && self.unlocked[i].node == node_idx
+            {
+                y[i] = discrepancy[(self.unlocked[i].component as usize, 0)];
+                i += 1;
+            }
+        }
+        Ok(())
+    }
+
+    /// Evaluates the residuals for the given (sorted) state-vector rows only,
+    /// computing each touched node's flux discrepancy exactly once.
+    fn residuals_for_rows(&self, rows: &[usize], out: &mut [f64]) -> anyhow::Result<()>
+    {
+        let mut k = 0;
+        while k < rows.len()
+        {
+            let node_idx = self.unlocked[rows[k]].node;
+            let discrepancy = self.nodes[node_idx as usize]
+                .try_borrow()?
+                .get_flux_discrepancy()?;
+
+            while k < rows.len() && self.unlocked[rows[k]].node == node_idx
+            {
+                out[k] = discrepancy[(self.unlocked[rows[k]].component as usize, 0)];
+                k += 1;
+            }
+        }
+        Ok(())
+    }
+
+    /// Drives every unlocked node's flux discrepancy to 0 with Newton
+    /// iteration, leaving the solution in the nodes themselves.
+    fn solve(&self, margin: f64, limit: usize) -> anyhow::Result<()>
+    {
+        let n = self.unlocked.len();
+        if n == 0
+        {
+            return Ok(());
+        }
+
+        let mut x = self.state()?;
+        let mut y = vec![0.0; n];
+        let mut y_dx = vec![0.0; n];
+
+        for _ in 0..limit
+        {
+            telemetry::count_iteration();
+            self.residuals(&mut y)?;
+            telemetry::count_residual_evals(n);
+            telemetry::record_final_residual(y.iter().map(|r| r.powi(2)).sum());
+            if y.iter().all(|r| r.abs() <= margin)
+            {
+                return Ok(());
+            }
+
+            // Build the finite-difference jacobian one structurally nonzero
+            // entry at a time. Each column writes its perturbed component
+            // exactly once, evaluates only the residuals its node can reach
+            // through the element network, and restores the component after
+            // the pass — construction cost scales with element count rather
+            // than the square of node count.
+            let mut triplets = Vec::new();
+            for j in 0..n
+            {
+                let rows = &self.coupled_rows[j];
+
+                self.write_component(j, x[j] + _DX_)?;
+                self.residuals_for_rows(rows, &mut y_dx[..rows.len()])?;
+                self.write_component(j, x[j])?;
+
+                for (k, &i) in rows.iter().enumerate()
+                {
+                    triplets.push((i, j, (y_dx[k] - y[i]) / _DX_));
+                }
+            }
+            let jacobian = SparseMatrix::from_triplets(n, n, triplets)?;
+            telemetry::count_jacobian_build();
+            telemetry::count_residual_evals(self.coupled_rows.iter().map(|r| r.len()).sum());
+
+            // An iterative solve keeps the step sparse end-to-end; fall back
+            // to a dense LU factorization if it fails to converge
+            let b = Matrix::from_col_vec(y.to_vec());
+            let step = match jacobian.try_solve_gauss_seidel(&b, margin, n * 10 + 100)
+            {
+                Result::Ok(s) => s,
+                Result::Err(_) => LuDecomposition::try_from_matrix(jacobian.to_dense())?.solve(&b)?,
+            };
+            telemetry::count_jacobian_solve();
+
+            for j in 0..n
+            {
+                x[j] -= step[(j, 0)];
+                self.write_component(j, x[j])?;
+            }
+        }
+        Err(NewtonRaphsonSolverError::ReachedIterationLimit.into())
+    }
+}
+
 #[derive(Clone, Debug, PartialEq, Serialize)]
 pub struct NodalAnalysisStudyResult
 {
@@ -213,7 +416,51 @@ impl NodalAnalysisStudyBuilder
         Ok(self)
     }
 
-    pub fn run_study(self) -> anyhow::Result<NodalAnalysisStudyResult>
+    /// Saves the model in the compact binary format understood by
+    /// `binary::load_model`. JSON (`save_model`) remains the interchange
+    /// format; the binary form exists for large generated networks where
+    /// parsing dominates load time.
+    pub fn save_model_binary(self, model_rep: &mut Vec<u8>) -> anyhow::Result<NodalAnalysisStudyBuilder>
+    {
+        *model_rep = binary::encode_model(&self.model)?;
+        Ok(self)
+    }
+
+    /// Extracts the structural incidence of the model from its element list:
+    /// for each node, the sorted set of nodes whose flux discrepancies its
+    /// potential can influence. Direct element connections give one hop;
+    /// elements whose flux calculation observes an adjacent node's flux
+    /// balance (e.g. voltage sources) couple potentials two hops apart, so
+    /// the one-hop adjacency is closed once more to stay conservative.
+    fn extract_incidence(&self) -> Vec<Vec<usize>>
+    {
+        let mut adjacent: Vec<HashSet<usize>> = (0..self.model.nodes)
+            .map(|i| HashSet::from([i]))
+            .collect();
+        for element in &self.model.elements
+        {
+            adjacent[element.input].insert(element.output);
+            adjacent[element.output].insert(element.input);
+        }
+
+        adjacent.iter()
+            .map(|neighbors| {
+                let mut reach: HashSet<usize> = neighbors.clone();
+                for &m in neighbors
+                {
+                    reach.extend(adjacent[m].iter());
+                }
+                let mut reach: Vec<usize> = reach.into_iter().collect();
+                reach.sort();
+                reach
+            })
+            .collect()
+    }
+
+    /// Builds the model's node/element network and solver engine exactly once
+    /// and hands them to a `TransientStudy` so they can be reused across many
+    /// solves. See `TransientStudy` for the stepping API.
+    pub fn build_transient_study(self) -> anyhow::Result<TransientStudy>
     {
         let n = self.get_dimension();
         let mut nodes = vec![];
@@ -255,68 +502,173 @@ impl NodalAnalysisStudyBuilder
             )?);
         }
 
-        // Step 4 - solve model
-        let mut partials = vec![];
-        let mut guess = HashMap::new();
-        for (node_idx, _) in nodes.iter().enumerate().filter(|(_, x)| !x.borrow().is_locked)
+        // Step 4 - build the solver engine for the network. Models built
+        // entirely from the stock flux formulas are rewritten into contiguous
+        // arena storage and solved there with parallel flux evaluation,
+        // monomorphized over the study dimension so the per-component loops
+        // unroll; anything with a custom flux calculation or an unexpected
+        // dimension stays on the graph engine.
+        let incidence = self.extract_incidence();
+        let engine = match n
         {
-            for comp_idx in 0..self.get_dimension()
-            {
-                let idx = ComponentIndex 
-                { 
-                    node: node_idx as u32, 
-                    component: comp_idx as u32 
-                };
-
-                let local_nodes = nodes.to_vec();
-
-                guess.insert(idx, 1.0);
-                partials.push(move |x: &HashMap<ComponentIndex, f64>| {
-                    for (&ComponentIndex { node, component }, &val) in x
-                    {
-                        local_nodes[node as usize]
-                            .try_borrow_mut()?
-                            .potential[(component as usize, 0)] = val;
-                    }
-
-                    let flux_discrepancy = local_nodes[node_idx]
-                        .try_borrow()?
-                        .get_flux_discrepancy()?;
-
-                    Ok(flux_discrepancy[(comp_idx, 0)])
-                });
-            }
+            1 => try_arena_engine::<1>(&nodes, &elements, &incidence).map(TransientEngine::Arena1),
+            2 => try_arena_engine::<2>(&nodes, &elements, &incidence).map(TransientEngine::Arena2),
+            3 => try_arena_engine::<3>(&nodes, &elements, &incidence).map(TransientEngine::Arena3),
+            _ => None,
+        }.unwrap_or_else(|| TransientEngine::Graph(NodalResidualEngine::new(nodes.to_vec(), &incidence)));
+
+        Ok(TransientStudy
+        {
+            model: self.model,
+            nodes,
+            elements,
+            engine,
+        })
+    }
+
+    pub fn run_study(self) -> anyhow::Result<NodalAnalysisStudyResult>
+    {
+        self.build_transient_study()?.step(0.0001, 100)
+    }
+}
+
+enum TransientEngine
+{
+    Arena1(ArenaResidualEngine<1>),
+    Arena2(ArenaResidualEngine<2>),
+    Arena3(ArenaResidualEngine<3>),
+    Graph(NodalResidualEngine),
+}
+
+/// Builds an arena engine for the network when the model can be rewritten
+/// into arena form for the given const dimension.
+fn try_arena_engine<const D: usize>(
+    nodes: &[Rc<RefCell<GenericNode>>],
+    elements: &[Rc<GenericElement>],
+    incidence: &[Vec<usize>],
+) -> Option<ArenaResidualEngine<D>>
+{
+    ArenaModel::<D>::try_from_graph(nodes, elements)
+        .map(|model| ArenaResidualEngine::new(model, incidence))
+}
+
+/// Runs one warm-started arena solve and returns the evaluated flux slab so
+/// results can be reported from the arena's own state.
+fn step_arena<const D: usize>(
+    engine: &mut ArenaResidualEngine<D>,
+    nodes: &[Rc<RefCell<GenericNode>>],
+    margin: f64,
+    limit: usize,
+) -> anyhow::Result<Vec<f64>>
+{
+    engine.solve(margin, limit)?;
+    engine.model.write_back(nodes)?;
+
+    let mut fluxes = vec![];
+    engine.model.eval_fluxes(&mut fluxes)?;
+    Ok(fluxes)
+}
+
+/// A nodal analysis study that can be re-solved many times against the same
+/// constructed network.
+///
+/// # Concept:
+/// A steady-state study pays for node construction, element construction,
+/// incidence extraction, and engine setup on every call to `run_study`. A
+/// transient simulation re-solves the same network hundreds of times with
+/// slowly moving boundary conditions, so the study keeps the network, the
+/// jacobian sparsity pattern, and the solver workspace alive across steps
+/// and starts each solve from the previous step's converged state. Small
+/// boundary perturbations then converge in a handful of Newton iterations
+/// instead of re-converging from cold guesses.
+pub struct TransientStudy
+{
+    model: NodalAnalysisModel,
+    nodes: Vec<Rc<RefCell<GenericNode>>>,
+    elements: Vec<Rc<GenericElement>>,
+    engine: TransientEngine,
+}
+impl TransientStudy
+{
+    /// Replaces an element's gain value between steps — e.g. the voltage of a
+    /// source or the flux of a constant-flux element following a schedule.
+    /// Only models solved on the arena engine support this; a model with
+    /// custom flux calculations returns a `GainUpdateUnsupported` error.
+    pub fn set_element_gain(&mut self, element: usize, gain: Vec<f64>) -> anyhow::Result<()>
+    {
+        match &mut self.engine
+        {
+            TransientEngine::Arena1(engine) => engine.model.set_gain(element, gain),
+            TransientEngine::Arena2(engine) => engine.model.set_gain(element, gain),
+            TransientEngine::Arena3(engine) => engine.model.set_gain(element, gain),
+            TransientEngine::Graph(_) => return Err(NodalAnalysisModellingError::GainUpdateUnsupported.into()),
         }
+        Ok(())
+    }
 
-        let soln = multivariate_newton_raphson(partials, &mut guess, 0.0001, 100)?;
+    /// Overwrites a node's potential between steps, e.g. to move a locked
+    /// boundary node along a prescribed trajectory.
+    pub fn set_node_potential(&mut self, node: usize, potential: Vec<f64>) -> anyhow::Result<()>
+    {
+        match &mut self.engine
+        {
+            TransientEngine::Arena1(engine) => engine.model.set_node_potential(node, &potential),
+            TransientEngine::Arena2(engine) => engine.model.set_node_potential(node, &potential),
+            TransientEngine::Arena3(engine) => engine.model.set_node_potential(node, &potential),
+            TransientEngine::Graph(_) => {},
+        }
+        self.nodes[node].try_borrow_mut()?.potential = Matrix::from_col_vec(potential);
+        Ok(())
+    }
 
-        // Step 5 - Set model state to solution
-        for (idx, component) in soln
+    /// Advances the study by one step: re-converges the model from its
+    /// current state and returns the solved potentials and element fluxes.
+    pub fn step(&mut self, margin: f64, limit: usize) -> anyhow::Result<NodalAnalysisStudyResult>
+    {
+        // Arena-solved models report fluxes from the arena itself, since an
+        // element gain updated between steps only lives there
+        let mut fluxes = None;
+        match &mut self.engine
         {
-            let mut node = nodes[idx.node as usize].try_borrow_mut()?;
-            node.potential[(idx.component as usize, 0)] = *component;
+            TransientEngine::Arena1(engine) => fluxes = Some(step_arena(engine, &self.nodes, margin, limit)?),
+            TransientEngine::Arena2(engine) => fluxes = Some(step_arena(engine, &self.nodes, margin, limit)?),
+            TransientEngine::Arena3(engine) => fluxes = Some(step_arena(engine, &self.nodes, margin, limit)?),
+            TransientEngine::Graph(engine) => engine.solve(margin, limit)?,
         }
 
-        // Step 6 - gather results
-        let mut result = NodalAnalysisStudyResult 
-        { 
-            nodes: HashMap::new(), 
-            elements: HashMap::new() 
+        self.gather_results(fluxes)
+    }
+
+    fn gather_results(&self, fluxes: Option<Vec<f64>>) -> anyhow::Result<NodalAnalysisStudyResult>
+    {
+        let mut result = NodalAnalysisStudyResult
+        {
+            nodes: HashMap::new(),
+            elements: HashMap::new()
         };
-        
-        for (idx, elem) in elements.iter().enumerate()
+
+        for (idx, elem) in self.elements.iter().enumerate()
         {
+            let flux: Vec<f64> = match &fluxes
+            {
+                Some(slab) => {
+                    let dim = slab.len() / self.elements.len();
+                    slab[idx * dim..(idx + 1) * dim].to_vec()
+                },
+                None => elem.get_flux()?.into(),
+            };
+
             result.elements.insert(
                 format!("{}.{idx}", self.model.elements[idx].element_type),
-                elem.get_flux()?.into()
+                flux
             );
         }
 
         // Get all nodal potential values for solution
-        for (idx, node) in nodes.iter().enumerate()
+        for (idx, node) in self.nodes.iter().enumerate()
         {
             result.nodes.insert(
-                idx as u32, 
+                idx as u32,
                 node.try_borrow()?.potential.clone().into(),
             );
         }
@@ -0,0 +1,497 @@
+/// Std modules
+use std::cell::RefCell;
+use std::collections::HashMap;
+use std::rc::Rc;
+
+/// 3rd party modules
+use rayon::prelude::*;
+
+/// Local modules
+use crate::Matrix;
+use crate::errors::FluxCalculationError;
+use crate::flux_formulas::{constant_flux, normal_flux, observe_flux};
+use crate::modelling::element::{FluxCalculation, GenericElement};
+use crate::modelling::node::GenericNode;
+
+/// The flux calculations the arena representation knows how to evaluate
+/// without calling through an `Rc<RefCell<GenericNode>>` graph.
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub (in crate) enum ArenaFlux
+{
+    Normal,
+    Constant,
+    Observe,
+}
+
+/// An element rewritten to address its nodes by index into the arena.
+#[derive(Clone, Debug)]
+pub (in crate) struct ArenaElement
+{
+    kind: ArenaFlux,
+    gain: Vec<f64>,
+    input: usize,
+    output: usize,
+    drives_output: bool,
+}
+
+/// An arena-backed copy of a built nodal analysis model, specialized over
+/// its potential dimension.
+///
+/// # Concept:
+/// The `Rc<RefCell<GenericNode>>` graph scatters nodes across the heap and
+/// pays refcount and borrow-flag traffic on every flux call, and the smart
+/// pointers make the whole model `!Send`. The arena keeps every nodal
+/// potential in one contiguous slab and every element in another, both
+/// addressed by index, so a residual pass is a cache-friendly sweep that can
+/// evaluate element fluxes on the rayon worker pool.
+///
+/// The dimension is a const generic so every per-component loop unrolls at
+/// compile time and scratch values live in fixed-size stack arrays — for the
+/// dimension-1 circuit studies a flux evaluation is a couple of scalar ops
+/// with zero allocation. Conversion only succeeds when every element uses
+/// one of the built-in flux formulas; a model with custom flux calculations
+/// (or a dimension nothing was monomorphized for) keeps using the
+/// graph-based engine.
+#[derive(Clone, Debug)]
+pub (in crate) struct ArenaModel<const D: usize>
+{
+    /// Node potentials, `D` entries per node
+    pub (in crate) potentials: Vec<f64>,
+    pub (in crate) locked: Vec<bool>,
+    pub (in crate) elements: Vec<ArenaElement>,
+    /// Elements registered with each node as inputs (flux adds to the balance)
+    inputs_of: Vec<Vec<usize>>,
+    /// Elements registered with each node as outputs (flux subtracts)
+    outputs_of: Vec<Vec<usize>>,
+    /// Indices of the `Observe` elements, which must be resolved after the
+    /// independent fluxes are available
+    observers: Vec<usize>,
+}
+
+impl<const D: usize> ArenaModel<D>
+{
+    /// Attempts to rewrite a built node/element graph into arena form.
+    /// Returns `None` when any element uses a flux calculation the arena
+    /// cannot evaluate or any node's potential is not `D`-dimensional.
+    pub (in crate) fn try_from_graph(nodes: &[Rc<RefCell<GenericNode>>], elements: &[Rc<GenericElement>]) -> Option<ArenaModel<D>>
+    {
+        let index_of: HashMap<*const RefCell<GenericNode>, usize> = nodes.iter()
+            .enumerate()
+            .map(|(i, n)| (Rc::as_ptr(n), i))
+            .collect();
+
+        let mut arena_elements = Vec::with_capacity(elements.len());
+        let mut inputs_of = vec![vec![]; nodes.len()];
+        let mut outputs_of = vec![vec![]; nodes.len()];
+        let mut observers = vec![];
+
+        for (elem_idx, elem) in elements.iter().enumerate()
+        {
+            #[allow(unpredictable_function_pointer_comparisons)]
+            let kind = match elem.flux_calc
+            {
+                f if f == normal_flux as FluxCalculation => ArenaFlux::Normal,
+                f if f == constant_flux as FluxCalculation => ArenaFlux::Constant,
+                f if f == observe_flux as FluxCalculation => ArenaFlux::Observe,
+                _ => return None,
+            };
+
+            let input = index_of[&Rc::as_ptr(&elem.input_node.upgrade()?)];
+            let output = index_of[&Rc::as_ptr(&elem.output_node.upgrade()?)];
+
+            // Recover which nodes were made aware of the element when it was
+            // constructed; only those see its flux in their balance
+            if nodes[input].borrow().outputs.iter().any(|e| Rc::ptr_eq(e, elem))
+            {
+                outputs_of[input].push(elem_idx);
+            }
+            if nodes[output].borrow().inputs.iter().any(|e| Rc::ptr_eq(e, elem))
+            {
+                inputs_of[output].push(elem_idx);
+            }
+
+            if kind == ArenaFlux::Observe
+            {
+                observers.push(elem_idx);
+            }
+
+            arena_elements.push(ArenaElement
+            {
+                kind,
+                gain: elem.gain.clone().into(),
+                input,
+                output,
+                drives_output: elem.drives_output,
+            });
+        }
+
+        let mut potentials = Vec::with_capacity(nodes.len() * D);
+        let mut locked = Vec::with_capacity(nodes.len());
+        for node in nodes
+        {
+            let node = node.borrow();
+            if node.potential.get_rows() != D
+            {
+                return None;
+            }
+            potentials.extend(Vec::from(node.potential.clone()));
+            locked.push(node.is_locked);
+        }
+
+        Some(ArenaModel
+        {
+            potentials,
+            locked,
+            elements: arena_elements,
+            inputs_of,
+            outputs_of,
+            observers,
+        })
+    }
+
+    /// Replaces an element's gain value, e.g. to step a boundary condition
+    /// between the time steps of a transient study.
+    pub (in crate) fn set_gain(&mut self, element: usize, gain: Vec<f64>)
+    {
+        self.elements[element].gain = gain;
+    }
+
+    /// Overwrites a node's potential in the arena slab.
+    pub (in crate) fn set_node_potential(&mut self, node: usize, potential: &[f64])
+    {
+        self.potentials[node * D..(node + 1) * D].copy_from_slice(potential);
+    }
+
+    /// Copies the arena's potentials back into the graph the model was
+    /// converted from so results can be gathered through the normal path.
+    pub (in crate) fn write_back(&self, nodes: &[Rc<RefCell<GenericNode>>]) -> anyhow::Result<()>
+    {
+        for (node_idx, node) in nodes.iter().enumerate()
+        {
+            let mut node = node.try_borrow_mut()?;
+            for c in 0..D
+            {
+                node.potential[(c, 0)] = self.potentials[node_idx * D + c];
+            }
+        }
+        Ok(())
+    }
+
+    /// Propagates driven potentials: every `Observe` element pins its driven
+    /// node's potential to the driver's potential plus/minus its gain. Chains
+    /// of driven nodes settle within one pass per observer.
+    pub (in crate) fn apply_driven_potentials(&mut self)
+    {
+        for _ in 0..self.observers.len()
+        {
+            for &elem_idx in &self.observers
+            {
+                let elem = &self.elements[elem_idx];
+                let (driver, driven, sign) = if elem.drives_output
+                {
+                    (elem.input, elem.output, 1.0)
+                }
+                else
+                {
+                    (elem.output, elem.input, -1.0)
+                };
+
+                for c in 0..D
+                {
+                    self.potentials[driven * D + c] =
+                        self.potentials[driver * D + c] + sign * elem.gain[c];
+                }
+            }
+        }
+    }
+
+    /// Evaluates the flux of a `Normal` or `Constant` element into `out`.
+    /// The loop bound is the const dimension, so it unrolls completely.
+    fn eval_independent_flux(&self, elem: &ArenaElement, out: &mut [f64])
+    {
+        match elem.kind
+        {
+            ArenaFlux::Normal => {
+                for c in 0..D
+                {
+                    out[c] = (self.potentials[elem.input * D + c]
+                        - self.potentials[elem.output * D + c]) * elem.gain[0];
+                }
+            },
+            ArenaFlux::Constant => out[..D].copy_from_slice(&elem.gain[..D]),
+            ArenaFlux::Observe => {},
+        }
+    }
+
+    /// Sums the flux balance of one node from an evaluated flux slab into a
+    /// stack-allocated array.
+    pub (in crate) fn discrepancy_from(&self, fluxes: &[f64], node: usize) -> [f64; D]
+    {
+        let mut out = [0.0; D];
+        for &e in &self.inputs_of[node]
+        {
+            for c in 0..D
+            {
+                out[c] += fluxes[e * D + c];
+            }
+        }
+        for &e in &self.outputs_of[node]
+        {
+            for c in 0..D
+            {
+                out[c] -= fluxes[e * D + c];
+            }
+        }
+        out
+    }
+
+    /// Resolves the given `Observe` elements against an already-evaluated
+    /// flux slab: each one's flux is the negated flux balance of the node it
+    /// drives. Observers whose driven node sees another unresolved observer
+    /// are retried until the chain settles.
+    fn resolve_observers(&self, observers: &[usize], fluxes: &mut [f64]) -> anyhow::Result<()>
+    {
+        let mut pending: Vec<usize> = observers.to_vec();
+
+        while !pending.is_empty()
+        {
+            let mut still_pending = vec![];
+            for &elem_idx in &pending
+            {
+                let elem = &self.elements[elem_idx];
+                let driven = if elem.drives_output { elem.output } else { elem.input };
+
+                // Defer if the driven node's balance includes an unresolved observer
+                let blocked = self.inputs_of[driven].iter()
+                    .chain(self.outputs_of[driven].iter())
+                    .any(|e| pending.contains(e) && *e != elem_idx);
+                if blocked
+                {
+                    still_pending.push(elem_idx);
+                    continue;
+                }
+
+                let discrepancy = self.discrepancy_from(fluxes, driven);
+                for c in 0..D
+                {
+                    fluxes[elem_idx * D + c] = -discrepancy[c];
+                }
+            }
+
+            if still_pending.len() == pending.len()
+            {
+                return Err(FluxCalculationError::ObserverCycle.into());
+            }
+            pending = still_pending;
+        }
+        Ok(())
+    }
+
+    /// Evaluates every element's flux into the `fluxes` slab, running the
+    /// independent elements in parallel on the rayon worker pool and
+    /// resolving the observers against the result.
+    pub (in crate) fn eval_fluxes(&self, fluxes: &mut Vec<f64>) -> anyhow::Result<()>
+    {
+        fluxes.resize(self.elements.len() * D, 0.0);
+        fluxes.par_chunks_mut(D)
+            .zip(self.elements.par_iter())
+            .for_each(|(out, elem)| self.eval_independent_flux(elem, out));
+
+        self.resolve_observers(&self.observers, fluxes)
+    }
+
+    /// Re-evaluates only the given elements against an existing flux slab —
+    /// the partial update used when a single potential component is perturbed
+    /// during jacobian assembly.
+    pub (in crate) fn eval_fluxes_of(&self, elements: &[usize], fluxes: &mut [f64]) -> anyhow::Result<()>
+    {
+        let mut observers = vec![];
+        for &elem_idx in elements
+        {
+            let elem = &self.elements[elem_idx];
+            if elem.kind == ArenaFlux::Observe
+            {
+                observers.push(elem_idx);
+                continue;
+            }
+
+            let start = elem_idx * D;
+            self.eval_independent_flux(elem, &mut fluxes[start..start + D]);
+        }
+
+        self.resolve_observers(&observers, fluxes)
+    }
+}
+
+/// The arena-backed counterpart to the graph engine in the crate root: the
+/// same sparse Newton iteration, but with residual assembly running over
+/// contiguous slabs and element fluxes evaluated in parallel.
+pub (in crate) struct ArenaResidualEngine<const D: usize>
+{
+    pub (in crate) model: ArenaModel<D>,
+    /// Flat state index -> (node, component)
+    unlocked: Vec<(usize, usize)>,
+    /// For each state-vector entry, the (sorted) entries whose residuals are
+    /// structurally coupled to it
+    coupled_rows: Vec<Vec<usize>>,
+    /// For each state-vector entry, the elements whose fluxes its potential
+    /// component can influence
+    affected_elems: Vec<Vec<usize>>,
+}
+
+impl<const D: usize> ArenaResidualEngine<D>
+{
+    pub (in crate) fn new(model: ArenaModel<D>, incidence: &[Vec<usize>]) -> ArenaResidualEngine<D>
+    {
+        let n_nodes = model.locked.len();
+
+        let mut unlocked = vec![];
+        let mut rows_of_node = vec![vec![]; n_nodes];
+        for node_idx in 0..n_nodes
+        {
+            if model.locked[node_idx]
+            {
+                continue;
+            }
+            for comp_idx in 0..D
+            {
+                rows_of_node[node_idx].push(unlocked.len());
+                unlocked.push((node_idx, comp_idx));
+            }
+        }
+
+        let mut elems_touching = vec![vec![]; n_nodes];
+        for (elem_idx, elem) in model.elements.iter().enumerate()
+        {
+            elems_touching[elem.input].push(elem_idx);
+            elems_touching[elem.output].push(elem_idx);
+        }
+
+        let mut coupled_rows = Vec::with_capacity(unlocked.len());
+        let mut affected_elems = Vec::with_capacity(unlocked.len());
+        for &(node_idx, _) in &unlocked
+        {
+            coupled_rows.push(
+                incidence[node_idx].iter()
+                    .flat_map(|&m| rows_of_node[m].iter().copied())
+                    .collect()
+            );
+
+            let mut affected: Vec<usize> = incidence[node_idx].iter()
+                .flat_map(|&m| elems_touching[m].iter().copied())
+                .collect();
+            affected.sort();
+            affected.dedup();
+            affected_elems.push(affected);
+        }
+
+        ArenaResidualEngine { model, unlocked, coupled_rows, affected_elems }
+    }
+
+    /// Reads the residuals for the given (sorted) state-vector rows out of an
+    /// evaluated flux slab, summing each touched node's balance exactly once.
+    fn residuals_for_rows(&self, fluxes: &[f64], rows: &[usize], out: &mut [f64])
+    {
+        let mut k = 0;
+        while k < rows.len()
+        {
+            let node_idx = self.unlocked[rows[k]].0;
+            let discrepancy = self.model.discrepancy_from(fluxes, node_idx);
+
+            while k < rows.len() && self.unlocked[rows[k]].0 == node_idx
+            {
+                out[k] = discrepancy[self.unlocked[rows[k]].1];
+                k += 1;
+            }
+        }
+    }
+
+    /// Drives every unlocked node's flux discrepancy to 0 with the same
+    /// sparse Newton iteration as the graph engine, leaving the solution in
+    /// the arena's potential slab.
+    pub (in crate) fn solve(&mut self, margin: f64, limit: usize) -> anyhow::Result<()>
+    {
+        let n = self.unlocked.len();
+        if n == 0
+        {
+            return Ok(());
+        }
+
+        let all_rows: Vec<usize> = (0..n).collect();
+        let mut x: Vec<f64> = self.unlocked.iter()
+            .map(|&(node, comp)| self.model.potentials[node * D + comp])
+            .collect();
+        let mut y = vec![0.0; n];
+        let mut y_dx = vec![0.0; n];
+        let mut fluxes = vec![];
+
+        for _ in 0..limit
+        {
+            geqslib::telemetry::count_iteration();
+            self.model.apply_driven_potentials();
+            self.model.eval_fluxes(&mut fluxes)?;
+            self.residuals_for_rows(&fluxes, &all_rows, &mut y);
+            geqslib::telemetry::count_residual_evals(n);
+            geqslib::telemetry::record_final_residual(y.iter().map(|r| r.powi(2)).sum());
+            if y.iter().all(|r| r.abs() <= margin)
+            {
+                return Ok(());
+            }
+
+            // Build the finite-difference jacobian from the structurally
+            // nonzero partials only, re-evaluating just the fluxes each
+            // perturbed component can influence
+            let mut triplets = Vec::new();
+            let mut saved = vec![];
+            for j in 0..n
+            {
+                let (node, comp) = self.unlocked[j];
+                let rows = &self.coupled_rows[j];
+                let affected = &self.affected_elems[j];
+
+                saved.clear();
+                saved.extend(affected.iter().flat_map(|&e| {
+                    fluxes[e * D..(e + 1) * D].iter().copied()
+                }));
+
+                self.model.potentials[node * D + comp] = x[j] + crate::_DX_;
+                self.model.apply_driven_potentials();
+                self.model.eval_fluxes_of(affected, &mut fluxes)?;
+                self.residuals_for_rows(&fluxes, rows, &mut y_dx[..rows.len()]);
+
+                // Restore the perturbed component and the fluxes it touched
+                self.model.potentials[node * D + comp] = x[j];
+                self.model.apply_driven_potentials();
+                for (k, &e) in affected.iter().enumerate()
+                {
+                    fluxes[e * D..(e + 1) * D]
+                        .copy_from_slice(&saved[k * D..(k + 1) * D]);
+                }
+
+                for (k, &i) in rows.iter().enumerate()
+                {
+                    triplets.push((i, j, (y_dx[k] - y[i]) / crate::_DX_));
+                }
+            }
+            let jacobian = gmatlib::sparse::SparseMatrix::from_triplets(n, n, triplets)?;
+            geqslib::telemetry::count_jacobian_build();
+            geqslib::telemetry::count_residual_evals(self.coupled_rows.iter().map(|r| r.len()).sum());
+
+            let b = Matrix::from_col_vec(y.to_vec());
+            let step = match jacobian.try_solve_gauss_seidel(&b, margin, n * 10 + 100)
+            {
+                Ok(s) => s,
+                Err(_) => gmatlib::lu::LuDecomposition::try_from_matrix(jacobian.to_dense())?.solve(&b)?,
+            };
+            geqslib::telemetry::count_jacobian_solve();
+
+            for j in 0..n
+            {
+                let (node, comp) = self.unlocked[j];
+                x[j] -= step[(j, 0)];
+                self.model.potentials[node * D + comp] = x[j];
+            }
+        }
+        Err(geqslib::errors::NewtonRaphsonSolverError::ReachedIterationLimit.into())
+    }
+}
@@ -68,11 +68,11 @@ pub type FluxCalculation = fn (Rc<RefCell<GenericNode>>, Rc<RefCell<GenericNode>
 #[derive(Clone, Debug)]
 pub struct GenericElement
 {
-    gain: Matrix<f64>,
-    input_node: Weak<RefCell<GenericNode>>,
-    output_node: Weak<RefCell<GenericNode>>,
-    flux_calc: FluxCalculation,
-    drives_output: bool,
+    pub (in crate) gain: Matrix<f64>,
+    pub (in crate) input_node: Weak<RefCell<GenericNode>>,
+    pub (in crate) output_node: Weak<RefCell<GenericNode>>,
+    pub (in crate) flux_calc: FluxCalculation,
+    pub (in crate) drives_output: bool,
 }
 impl GenericElement
 {
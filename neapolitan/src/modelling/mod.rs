@@ -1,3 +1,4 @@
+pub (in crate) mod arena;
 pub mod element;
 pub mod node;
 
@@ -54,4 +54,88 @@ fn fuzz_resistor_flux_calcs()
 
         assert!(expected - res.get_flux().unwrap()[(0, 0)] < 1E-10);
     }
-}
\ No newline at end of file
+}
+#[test]
+fn voltage_divider_solves_to_expected_potentials()
+{
+    let builder = NodalAnalysisStudyBuilder::new(SSDC_CIRCUIT.to_string(), None)
+        .expect("failed to create model builder object");
+
+    // A 3V source driving three series resistors: 0.75A flows through the loop
+    let soln = builder
+        .add_nodes(4)
+        .configure_node(0, vec![0.0], true, None)
+        .add_element(VOLTAGE_SOURCE, 0, 1, vec![3.0]).expect("Failed to make voltage source")
+        .add_element(RESISTOR,       1, 2, vec![2.0]).expect("Failed to make 2 ohm resistor")
+        .add_element(RESISTOR,       2, 3, vec![1.0]).expect("Failed to make first 1 ohm resistor")
+        .add_element(RESISTOR,       3, 0, vec![1.0]).expect("Failed to make second 1 ohm resistor")
+        .run_study().expect("Failed to solve model");
+
+    let rep = serde_json::to_value(&soln).expect("failed to serialize solution");
+
+    assert!((rep["nodes"]["1"][0].as_f64().unwrap() - 3.00).abs() < 0.001);
+    assert!((rep["nodes"]["2"][0].as_f64().unwrap() - 1.50).abs() < 0.001);
+    assert!((rep["nodes"]["3"][0].as_f64().unwrap() - 0.75).abs() < 0.001);
+}
+
+#[test]
+fn transient_study_tracks_a_ramped_source()
+{
+    let builder = NodalAnalysisStudyBuilder::new(SSDC_CIRCUIT.to_string(), None)
+        .expect("failed to create model builder object");
+
+    let mut study = builder
+        .add_nodes(4)
+        .configure_node(0, vec![0.0], true, None)
+        .add_element(VOLTAGE_SOURCE, 0, 1, vec![3.0]).expect("Failed to make voltage source")
+        .add_element(RESISTOR,       1, 2, vec![2.0]).expect("Failed to make 2 ohm resistor")
+        .add_element(RESISTOR,       2, 3, vec![1.0]).expect("Failed to make first 1 ohm resistor")
+        .add_element(RESISTOR,       3, 0, vec![1.0]).expect("Failed to make second 1 ohm resistor")
+        .build_transient_study().expect("Failed to build transient study");
+
+    // Ramp the source from 3V to 4V; every step re-converges from the last state
+    for i in 0..=10
+    {
+        let volts = 3.0 + 0.1 * i as f64;
+        study.set_element_gain(0, vec![volts]).expect("Failed to update source voltage");
+        let soln = study.step(0.0001, 100).expect("Failed to solve step");
+
+        let rep = serde_json::to_value(&soln).expect("failed to serialize solution");
+        assert!((rep["nodes"]["2"][0].as_f64().unwrap() - volts / 2.0).abs() < 0.001);
+        assert!((rep["nodes"]["3"][0].as_f64().unwrap() - volts / 4.0).abs() < 0.001);
+    }
+}
+
+#[test]
+fn binary_model_round_trips_and_solves()
+{
+    use std::collections::HashMap;
+    use neapolitan::binary::load_model;
+
+    let mut json = String::new();
+    let mut bin = vec![];
+
+    NodalAnalysisStudyBuilder::new(SSDC_CIRCUIT.to_string(), None)
+        .expect("failed to create model builder object")
+        .add_nodes(4)
+        .configure_node(0, vec![0.0], true, Some(HashMap::from([("ground".to_string(), 1.0)])))
+        .add_element(VOLTAGE_SOURCE, 0, 1, vec![3.0]).expect("Failed to make voltage source")
+        .add_element(RESISTOR,       1, 2, vec![2.0]).expect("Failed to make 2 ohm resistor")
+        .add_element(RESISTOR,       2, 3, vec![1.0]).expect("Failed to make first 1 ohm resistor")
+        .add_element(RESISTOR,       3, 0, vec![1.0]).expect("Failed to make second 1 ohm resistor")
+        .save_model(&mut json).expect("Failed to save JSON model")
+        .save_model_binary(&mut bin).expect("Failed to save binary model");
+
+    let path = std::env::temp_dir().join("neapolitan_round_trip_test.napm");
+    std::fs::write(&path, &bin).expect("failed to write binary model");
+
+    // The memory-mapped load must reproduce the JSON model exactly
+    let loaded = load_model(&path).expect("failed to load binary model");
+    assert_eq!(loaded, serde_json::from_str(&json).expect("failed to parse JSON model"));
+
+    // ...and the loaded model must still solve
+    let soln = NodalAnalysisStudyBuilder::from_model_with_default_config(loaded)
+        .run_study().expect("Failed to solve loaded model");
+    let rep = serde_json::to_value(&soln).expect("failed to serialize solution");
+    assert!((rep["nodes"]["2"][0].as_f64().unwrap() - 1.5).abs() < 0.001);
+}
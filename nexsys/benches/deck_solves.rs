@@ -0,0 +1,106 @@
+//! End-to-end benchmarks for the full nexsys pipeline: preprocessor,
+//! compiler, constraint solver, and Newton iteration.
+//!
+//! Unlike the criterion kernels in gmatlib, these measure whole decks the
+//! way `nxc` would run them and report wall time, peak heap, and allocation
+//! counts from a counting global allocator, plus the solver telemetry
+//! counters from `geqslib::telemetry`. Run with `cargo bench -p nexsys`.
+
+use std::alloc::{GlobalAlloc, Layout, System};
+use std::fmt::Write;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::time::Instant;
+
+use geqslib::telemetry::{reset_solver_telemetry, solver_telemetry};
+use nexsys::solve_with_preprocessors;
+
+/// The deck sizes every workload sweeps over, in coupled 2-equation blocks.
+const _SIZES_: [usize; 3] = [50, 200, 500];
+
+/// A `System` wrapper that tallies every allocation so the benchmarks can
+/// report peak heap and allocation counts alongside wall time.
+struct CountingAllocator;
+
+static ALLOCATIONS: AtomicUsize = AtomicUsize::new(0);
+static LIVE_BYTES: AtomicUsize = AtomicUsize::new(0);
+static PEAK_BYTES: AtomicUsize = AtomicUsize::new(0);
+
+unsafe impl GlobalAlloc for CountingAllocator
+{
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8
+    {
+        ALLOCATIONS.fetch_add(1, Ordering::Relaxed);
+        let live = LIVE_BYTES.fetch_add(layout.size(), Ordering::Relaxed) + layout.size();
+        PEAK_BYTES.fetch_max(live, Ordering::Relaxed);
+        System.alloc(layout)
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout)
+    {
+        LIVE_BYTES.fetch_sub(layout.size(), Ordering::Relaxed);
+        System.dealloc(ptr, layout)
+    }
+}
+
+#[global_allocator]
+static ALLOC: CountingAllocator = CountingAllocator;
+
+/// Zeroes the allocation counters; peak restarts from the bytes currently live.
+fn reset_alloc_counters()
+{
+    ALLOCATIONS.store(0, Ordering::Relaxed);
+    PEAK_BYTES.store(LIVE_BYTES.load(Ordering::Relaxed), Ordering::Relaxed);
+}
+
+/// Generates a representative deck of `blocks` independent 2-equation
+/// systems, exercising comments, `#const` substitution, unit conversions,
+/// and `guess` directives the way a hand-written deck would.
+fn representative_deck(blocks: usize) -> String
+{
+    let mut deck = String::from("// generated benchmark deck\n");
+    for i in 0..blocks
+    {
+        let sum = 9.0 + (i % 7) as f64;
+        let diff = 4.0 + (i % 3) as f64;
+        writeln!(deck, "guess {} for x{i}", sum).unwrap();
+        writeln!(deck, "x{i} + y{i} = {sum} * [m->cm] / [m->cm] // block {i}").unwrap();
+        writeln!(deck, "x{i} - y{i} = {diff} * #pi / #pi").unwrap();
+    }
+    deck
+}
+
+/// Runs one deck through `solve_with_preprocessors` and prints one report line.
+fn run_workload(label: &str, deck: &str)
+{
+    reset_alloc_counters();
+    reset_solver_telemetry();
+
+    let start = Instant::now();
+    let (log, soln) = solve_with_preprocessors(deck, 0.0001, 100)
+        .expect("benchmark deck failed to solve");
+    let elapsed = start.elapsed();
+
+    let stats = solver_telemetry();
+    println!(
+        "{label}: {:>6} vars in {:>9.3?} | peak heap {:>9} B, {:>8} allocs | {} iters, {} residual evals, {} jacobian builds, {} solves, final residual {:.3e} | {} log entries",
+        soln.len(),
+        elapsed,
+        PEAK_BYTES.load(Ordering::Relaxed),
+        ALLOCATIONS.load(Ordering::Relaxed),
+        stats.iterations,
+        stats.residual_evals,
+        stats.jacobian_builds,
+        stats.jacobian_solves,
+        stats.final_residual,
+        log.len(),
+    );
+}
+
+fn main()
+{
+    for blocks in _SIZES_
+    {
+        let deck = representative_deck(blocks);
+        run_workload(&format!("deck_solve/{blocks}_blocks"), &deck);
+    }
+}
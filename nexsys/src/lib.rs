@@ -8,13 +8,16 @@ pub mod parsing;
 /// Provides data sets of common units and functions for converting between them.
 pub mod units;
 
-use std::collections::HashMap;
+use std::collections::{HashMap, HashSet};
 
+use rayon::prelude::*;
+
+use geqslib::errors::NewtonRaphsonSolverError;
 use geqslib::solve_equation_with_context;
 use geqslib::shunting::{new_context, ContextHashMap, ContextLike, Token};
 use geqslib::system::{ConstrainResult, get_equation_unknowns, SystemBuilder};
 
-use parsing::compile;
+use parsing::{compile, compile_stream};
 
 /// Solves a single equation for a single unknown value, returning a `bool` indicating if the solution attempt was successful 
 fn try_solve_single_unknown_eqn(eqn_pool: &mut Vec<String>, ctx: &mut ContextHashMap, declared: &mut HashMap<String, [f64; 3]>, log_step: &mut String, margin: f64, limit: usize) -> anyhow::Result<bool>
@@ -163,7 +166,214 @@ pub fn basic_solve(system: &str, ctx: &mut ContextHashMap, declared: &mut HashMa
     Ok((log, soln_map))
 }
 
-/// Solves a system of equations with additional syntax used to indicate 
+/// Groups the equations in the pool into connected components of the
+/// equation-variable dependency graph and returns the components that are
+/// fully constrained (equation count equals unknown count) as lists of
+/// indices into the pool. Components returned together share NO unknowns,
+/// so they can be solved independently.
+fn find_independent_subsystems(eqn_pool: &[String], ctx: &ContextHashMap) -> Vec<Vec<usize>>
+{
+    fn find(parent: &mut Vec<usize>, mut i: usize) -> usize
+    {
+        while parent[i] != i
+        {
+            parent[i] = parent[parent[i]]; // path compression
+            i = parent[i];
+        }
+        i
+    }
+
+    // Union equations that share an unknown
+    let mut parent: Vec<usize> = (0..eqn_pool.len()).collect();
+    let mut claimed_by: HashMap<String, usize> = HashMap::new();
+    for (i, equation) in eqn_pool.iter().enumerate()
+    {
+        for unknown in get_equation_unknowns(equation, ctx)
+        {
+            match claimed_by.get(unknown)
+            {
+                Some(&j) => {
+                    let (ri, rj) = (find(&mut parent, i), find(&mut parent, j));
+                    parent[ri] = rj;
+                },
+                None => {
+                    claimed_by.insert(unknown.to_owned(), i);
+                },
+            }
+        }
+    }
+
+    // Collect each component's equations and distinct unknowns
+    let mut components: HashMap<usize, (Vec<usize>, HashSet<String>)> = HashMap::new();
+    for (i, equation) in eqn_pool.iter().enumerate()
+    {
+        let root = find(&mut parent, i);
+        let component = components.entry(root).or_default();
+        component.0.push(i);
+        component.1.extend(
+            get_equation_unknowns(equation, ctx).map(|u| u.to_owned())
+        );
+    }
+
+    components.into_values()
+        .filter(|(eqns, unknowns)| !unknowns.is_empty() && eqns.len() == unknowns.len())
+        .map(|(eqns, _)| eqns)
+        .collect()
+}
+
+/// Solves one fully-constrained group of equations on a worker thread.
+/// The `Rc`-based `ContextHashMap` cannot cross thread boundaries, so the
+/// group is solved against a private context rebuilt from the plain-data
+/// snapshots of the shared context's constants and functions.
+fn solve_constrained_group(group: &[String], consts: &[(String, f64)], funcs: &[(String, usize, fn(&[f64]) -> f64)], declared: &HashMap<String, [f64; 3]>, margin: f64, limit: usize) -> anyhow::Result<HashMap<String, f64>>
+{
+    let mut ctx = ContextHashMap::new();
+    for (name, val) in consts
+    {
+        ctx.add_const_to_ctx(name, *val);
+    }
+    for (name, args, func) in funcs
+    {
+        ctx.add_func_to_ctx(name, *func, *args);
+    }
+
+    let mut builder = SystemBuilder::new(&group[0], ctx)?;
+    builder.try_fully_constrain_with(
+        group[1..].iter().map(|x| x.as_str()).collect()
+    )?;
+
+    let mut system = builder.build_system()
+        .ok_or(NewtonRaphsonSolverError::ImproperlyConstrainedSystem)?;
+
+    for (var, var_info) in declared
+    {
+        system.specify_variable(var, var_info[0], var_info[1], var_info[2]);
+    }
+
+    system.solve(margin, limit)
+}
+
+/// Solves a system of equations in plain-text format like `basic_solve`,
+/// but dispatches mutually independent constrained subsystems to the
+/// rayon thread pool instead of solving them one at a time.
+///
+/// Each pass builds the equation-variable dependency graph explicitly:
+/// equations sharing an unknown land in the same connected component, and
+/// every fully-constrained component is solved on its own worker against
+/// a private context. Solved values merge back into the shared
+/// `ContextHashMap` between waves, which can unlock further components.
+/// Anything the wave logic cannot place falls back to the same greedy
+/// passes `basic_solve` uses.
+///
+/// # Example
+/// ```
+/// use std::collections::HashMap;
+/// use nexsys::parallel_solve;
+/// use geqslib::shunting::new_context;
+///
+/// // Two independent flow-loop-style branches...
+/// let system = "x + y = 9\nx - y = 4\na + b = 3\na - b = 1";
+///
+/// let mut ctx = new_context();
+/// let mut declared = HashMap::new();
+///
+/// // ...solved concurrently in one wave
+/// let (_log, soln) = parallel_solve(system, &mut ctx, &mut declared, 0.0001, 100)
+///     .expect("failed to solve system!");
+///
+/// assert!((soln["x"] - 6.5).abs() < 0.001);
+/// assert!((soln["y"] - 2.5).abs() < 0.001);
+/// assert!((soln["a"] - 2.0).abs() < 0.001);
+/// assert!((soln["b"] - 1.0).abs() < 0.001);
+/// ```
+pub fn parallel_solve(system: &str, ctx: &mut ContextHashMap, declared: &mut HashMap<String, [f64; 3]>, margin: f64, limit: usize) -> anyhow::Result<(Vec<String>, HashMap<String, f64>)>
+{
+    let mut log = vec![];
+    let mut eqn_pool: Vec<String> = system.split('\n')
+        .filter(|x| x.contains('='))
+        .map(|x| x.to_owned())
+        .collect();
+
+    loop
+    {
+        // Dispatch every independent constrained subsystem in one wave
+        let ready: Vec<Vec<String>> = find_independent_subsystems(&eqn_pool, ctx)
+            .into_iter()
+            .map(|group| group.into_iter().map(|i| eqn_pool[i].clone()).collect())
+            .collect();
+
+        if !ready.is_empty()
+        {
+            // Snapshot the shared context's knowns as plain data the
+            // workers can take across thread boundaries
+            let mut consts = vec![];
+            let mut funcs = vec![];
+            for (name, token) in ctx.iter()
+            {
+                match token
+                {
+                    Token::Num(n) => consts.push((name.clone(), *n)),
+                    Token::Var(v) => consts.push((name.clone(), f64::from(*v.borrow()))),
+                    Token::Func(args, func) => funcs.push((name.clone(), *args, *func)),
+                    _ => {},
+                }
+            }
+
+            let results: Vec<anyhow::Result<HashMap<String, f64>>> = ready.par_iter()
+                .map(|group| solve_constrained_group(group, &consts, &funcs, declared, margin, limit))
+                .collect();
+
+            // Merge each worker's solution back into the shared context
+            for (group, result) in ready.iter().zip(results)
+            {
+                for (var, val) in result?
+                {
+                    ctx.add_const_to_ctx(&var, val);
+                }
+                log.push(format!("{:#?}", group));
+            }
+
+            eqn_pool.retain(|x| !ready.iter().any(|group| group.contains(x)));
+            continue;
+        }
+
+        let mut log_step = String::default();
+        // Get less expensive solutions:
+        if try_solve_single_unknown_eqn(&mut eqn_pool, ctx, declared, &mut log_step, margin, limit)?
+        {
+            log.push(log_step);
+            continue;
+        }
+
+        // Dig in and solve a more expensive subsystem:
+        if try_solve_subsystem_of_equations(&mut eqn_pool, ctx, declared, &mut log_step, margin, limit)?
+        {
+            log.push(log_step);
+            continue;
+        }
+
+        break;
+    }
+
+    let mut soln_map = HashMap::new();
+    for (name, val) in ctx
+    {
+        match val
+        {
+            Token::Var(v) => {
+                soln_map.insert(name.to_owned(), f64::from(*v.borrow()));
+            },
+            Token::Num(n) => {
+                soln_map.insert(name.to_owned(), *n);
+            },
+            _ => {}
+        }
+    }
+
+    Ok((log, soln_map))
+}
+
+/// Solves a system of equations with additional syntax used to indicate
 /// unit conversions, constant known values, nicer if statements, and more.
 /// 
 /// # Example
@@ -194,9 +404,139 @@ pub fn basic_solve(system: &str, ctx: &mut ContextHashMap, declared: &mut HashMa
 /// ```
 pub fn solve_with_preprocessors(system: &str, margin: f64, limit: usize) -> anyhow::Result<(Vec<String>, HashMap<String, f64>)>
 {
-    let mut ctx = new_context(); 
+    let mut ctx = new_context();
     let mut declared = HashMap::new();
     let compiled = compile(system, &mut ctx, &mut declared)?;
 
     basic_solve(&compiled, &mut ctx, &mut declared, margin, limit)
-}
\ No newline at end of file
+}
+
+/// Solves a system of equations read directly from a buffered source,
+/// supporting the same syntax as `solve_with_preprocessors`.
+///
+/// The source is compiled in a single streaming pass, so a large `.nxs`
+/// file never needs to be read into memory before preprocessing begins.
+///
+/// # Example
+/// ```
+/// use nexsys::solve_from_reader;
+///
+/// let system: &[u8] = b"
+/// guess 3 for y
+/// x + y = 9 // a comment the solver never sees
+/// x - y = 4
+/// ";
+///
+/// let (_log, soln) = solve_from_reader(system, 0.0001, 100)
+///     .expect("failed to solve system!");
+///
+/// assert!((f64::from(soln["x"]) - 6.5).abs() < 0.001);
+/// assert!((f64::from(soln["y"]) - 2.5).abs() < 0.001);
+/// ```
+pub fn solve_from_reader<R: std::io::BufRead>(reader: R, margin: f64, limit: usize) -> anyhow::Result<(Vec<String>, HashMap<String, f64>)>
+{
+    let mut ctx = new_context();
+    let mut declared = HashMap::new();
+    let compiled = compile_stream(reader, &mut ctx, &mut declared)?;
+
+    basic_solve(&compiled, &mut ctx, &mut declared, margin, limit)
+}
+/// Caches solved variable maps so that re-solving a structurally identical
+/// system starts Newton iteration from the previous solution instead of the
+/// default guess of 1.0.
+///
+/// Two decks are structurally identical when they compile to the same
+/// equations up to their numeric literals — the edit-rerun case where a user
+/// tweaks one boundary condition or constant and runs the deck again. A
+/// near-converged starting point typically cuts the iteration count by an
+/// order of magnitude for small perturbations.
+///
+/// # Example
+/// ```
+/// use nexsys::SolutionCache;
+///
+/// let mut cache = SolutionCache::new();
+///
+/// let (_log, first) = cache.solve("x + y = 9 \n x - y = 4", 0.0001, 100)
+///     .expect("failed to solve system!");
+///
+/// // Same structure, perturbed constant: x and y start from the values above
+/// let (_log, second) = cache.solve("x + y = 9.1 \n x - y = 4", 0.0001, 100)
+///     .expect("failed to solve system!");
+///
+/// assert!((first["x"] - 6.5).abs() < 0.001);
+/// assert!((second["x"] - 6.55).abs() < 0.001);
+/// ```
+pub struct SolutionCache
+{
+    solutions: HashMap<String, HashMap<String, f64>>,
+}
+
+impl SolutionCache
+{
+    /// Creates a new, empty `SolutionCache`.
+    pub fn new() -> SolutionCache
+    {
+        SolutionCache { solutions: HashMap::new() }
+    }
+
+    /// Builds the cache key for a compiled deck: its equations with numeric
+    /// literals masked and whitespace removed, sorted so that reordering
+    /// lines does not defeat the cache. The word boundary keeps the mask
+    /// off digits inside identifiers — `x1` must not collide with `x2`.
+    fn structural_key(compiled: &str) -> String
+    {
+        lazy_static::lazy_static!
+        {
+            static ref NUM_RE: regex::Regex = regex::Regex::new(r"\b[0-9]+\.?[0-9]*").unwrap();
+        }
+        let mut eqns: Vec<String> = compiled.split('\n')
+            .filter(|x| x.contains('='))
+            .map(|x| NUM_RE.replace_all(x, "#").replace(' ', ""))
+            .collect();
+        eqns.sort();
+        eqns.join("\n")
+    }
+
+    /// Solves a system of equations with the same syntax support as
+    /// `solve_with_preprocessors`, seeding each variable's initial guess from
+    /// the last cached solution of a structurally identical system. Cached
+    /// values falling outside a variable's declared domain are ignored.
+    pub fn solve(&mut self, system: &str, margin: f64, limit: usize) -> anyhow::Result<(Vec<String>, HashMap<String, f64>)>
+    {
+        let mut ctx = new_context();
+        let mut declared = HashMap::new();
+        let compiled = compile(system, &mut ctx, &mut declared)?;
+        let key = SolutionCache::structural_key(&compiled);
+
+        if let Some(cached) = self.solutions.get(&key)
+        {
+            for (var, val) in cached
+            {
+                if let Some(var_info) = declared.get_mut(var)
+                {
+                    if var_info[1] <= *val && *val <= var_info[2]
+                    {
+                        var_info[0] = *val;
+                    }
+                }
+                else
+                {
+                    declared.insert(var.to_owned(), [*val, f64::NEG_INFINITY, f64::INFINITY]);
+                }
+            }
+        }
+
+        let res = basic_solve(&compiled, &mut ctx, &mut declared, margin, limit)?;
+        self.solutions.insert(key, res.1.clone());
+        Ok(res)
+    }
+}
+
+impl Default for SolutionCache
+{
+    fn default() -> Self
+    {
+        SolutionCache::new()
+    }
+}
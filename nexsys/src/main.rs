@@ -1,6 +1,78 @@
 use std::{env, process};
-use std::fs::{read_to_string, write};
-use nexsys::{solve_with_preprocessors, parsing::{conditionals, conversions, consts}};
+use std::fs::{read_to_string, write, File};
+use std::io::{BufRead, BufReader, Write};
+use std::sync::mpsc::channel;
+use nexsys::{solve_from_reader, solve_with_preprocessors, parsing::{conditionals, conversions, consts}, units::{const_table, unit_table}};
+
+/// Formats a solved system the same way the one-shot path does.
+fn format_solution(label: &str, log: Vec<String>, soln: std::collections::HashMap<String, f64>) -> String {
+    format!(
+        "[->] Nexsys - {} results:\n\nSolution:\n+=======+\n{}\nProcedure:\n+========+\n{}\n",
+        label,
+        soln.into_iter()
+            .map(|(name, val)| format!("{} = {}\n", name, val))
+            .collect::<String>(),
+        log.join("\n")
+    )
+}
+
+/// Runs nxc as a long-lived daemon, reading `%%`-delimited decks from stdin
+/// and writing a `%%`-terminated response per deck to stdout.
+///
+/// The unit and constant tables are parsed once up front and every deck
+/// after the first reuses them, so callers that solve many files amortize
+/// all startup cost across the whole session. Decks are solved concurrently
+/// on the rayon worker pool; responses come back in completion order and
+/// carry the request number they answer.
+fn run_server(margin: f64, limit: usize) -> ! {
+    // Touch the lazily-built tables now so no worker pays for them later
+    let _ = unit_table();
+    let _ = const_table();
+
+    let (tx, rx) = channel::<(usize, String)>();
+
+    // A dedicated printer thread keeps responses from interleaving
+    let printer = std::thread::spawn(move || {
+        let stdout = std::io::stdout();
+        for (id, response) in rx {
+            let mut out = stdout.lock();
+            writeln!(out, "[nxc].....request {id}\n{response}%%").unwrap();
+            out.flush().unwrap();
+        }
+    });
+
+    println!("[nxc].....serving; terminate each deck with a line containing only %%");
+
+    let stdin = std::io::stdin();
+    let mut deck = String::new();
+    let mut next_id = 0;
+
+    for line in stdin.lock().lines() {
+        let line = line.unwrap_or_default();
+        if line.trim() != "%%" {
+            deck.push_str(&line);
+            deck.push('\n');
+            continue;
+        }
+
+        let id = next_id;
+        next_id += 1;
+        let system = std::mem::take(&mut deck);
+        let tx = tx.clone();
+
+        rayon::spawn(move || {
+            let response = match solve_with_preprocessors(&system, margin, limit) {
+                Ok((log, soln)) => format_solution(&format!("request {id}"), log, soln),
+                Err(e) => format!("[nxc].....ERR: nxc could not solve the system\n[nxc].....{e}\n"),
+            };
+            tx.send((id, response)).unwrap();
+        });
+    }
+
+    drop(tx);
+    printer.join().unwrap();
+    process::exit(0);
+}
 
 fn main() {
     let args: Vec<String> = env::args().collect();
@@ -17,21 +89,16 @@ OPTIONS:
 --max-iterations, -max <int>           The maximum number of iterations that the solver can take to converge
 --output-file, -o                      Sends the results to a .txt file rather than printing them in the terminal
 --verbose -v                           Prints compiled nexsys code in the terminal for debugging
+--serve, -s                            Runs nxc as a daemon, solving %%-delimited decks read from stdin
 "#);
         process::exit(0);
     }
 
-    let system = match read_to_string(&args[1]) {
-        Ok(o) => o,
-        Err(_) => {
-            println!("[nxc].....ERR: could not find the specified filepath");
-            process::exit(1);
-        }
-    };
-
     let mut margin = 0.0001;
-    let mut limit = 100; 
+    let mut limit = 100;
     let mut output_file = false; // todo: make this produce different file types
+    let mut verbose = false;
+    let mut serve = false;
 
     for i in 0..args.len() {
         if args[i] == *"--margin" || args[i] == *"-tol" {
@@ -59,21 +126,54 @@ OPTIONS:
             }
         }
         if args[i] == *"--verbose" || args[i] == *"-v" {
-            println!("[nxc].....Printing compiled code...");
-
-            let mut preprocess = conversions(&system).unwrap();
-            preprocess = consts(&preprocess).unwrap();
-            preprocess = conditionals(&preprocess).unwrap();
-            
-            println!("\n{preprocess}\n");
+            verbose = true;
         }
         if args[i] == *"--to-file" || args[i] == *"-o" {
             println!("[nxc].....Writing to file...");
             output_file = true;
         }
+        if args[i] == *"--serve" || args[i] == *"-s" {
+            serve = true;
+        }
     }
 
-    let (log, soln) = match solve_with_preprocessors(&system, margin, limit) {
+    if serve {
+        run_server(margin, limit);
+    }
+
+    // The verbose path needs the whole source in memory for its debug dump;
+    // otherwise the file is streamed through the preprocessor line by line.
+    let solved = if verbose {
+        let system = match read_to_string(&args[1]) {
+            Ok(o) => o,
+            Err(_) => {
+                println!("[nxc].....ERR: could not find the specified filepath");
+                process::exit(1);
+            }
+        };
+
+        println!("[nxc].....Printing compiled code...");
+
+        let mut preprocess = conversions(&system).unwrap();
+        preprocess = consts(&preprocess).unwrap();
+        preprocess = conditionals(&preprocess).unwrap();
+
+        println!("\n{preprocess}\n");
+
+        solve_with_preprocessors(&system, margin, limit)
+    } else {
+        let file = match File::open(&args[1]) {
+            Ok(o) => o,
+            Err(_) => {
+                println!("[nxc].....ERR: could not find the specified filepath");
+                process::exit(1);
+            }
+        };
+
+        solve_from_reader(BufReader::new(file), margin, limit)
+    };
+
+    let (log, soln) = match solved {
         Ok(o) => o,
         Err(e) => {
             println!("[nxc].....ERR: nxc could not solve the system");
@@ -82,14 +182,7 @@ OPTIONS:
         }
     };
 
-    let output = format!(
-        "[->] Nexsys - {} results:\n\nSolution:\n+=======+\n{}\nProcedure:\n+========+\n{}\n",
-        &args[1],
-        soln.into_iter()
-            .map(|(name, val)| format!("{} = {}\n", name, val))
-            .collect::<String>(),
-        log.join("\n")
-    );
+    let output = format_solution(&args[1], log, soln);
 
     if output_file {
         match write(args[1].replace(".nxs", ".txt"), output) {
@@ -5,7 +5,8 @@ use geqslib::shunting::{eval_str, ContextHashMap, ContextLike};
 use lazy_static::lazy_static;
 use regex::Regex;
 use std::collections::HashMap;
-use crate::{units::{convert, const_data}, errors::ConstFormatError};
+use std::io::BufRead;
+use crate::{units::{convert, const_table}, errors::ConstFormatError};
 
 pub use conditionals::*;
 
@@ -112,17 +113,17 @@ pub fn conversions(text: &str) -> anyhow::Result<String> {
 /// Identifies and replaces any constants in a Nexsys-legal string.
 pub fn consts(text: &str) -> anyhow::Result<String> 
 {
-    lazy_static! 
+    lazy_static!
     {
         static ref RE: Regex = nexsys_regex(r"(?i)#[a-z_]+");
-        static ref CONSTS: HashMap<String, f64> = const_data();
     }
+    let consts = const_table();
 
     let mut output = text.to_string();
 
     for m in RE.find_iter(text).map(|i| i.as_str()) 
     {
-        if let Some(c) = CONSTS.get(&m.to_string()) 
+        if let Some(c) = consts.get(&m.to_string())
         {
             output = output.replace(m, &c.to_string());
         } 
@@ -154,63 +155,163 @@ pub fn const_values(text: &str) -> anyhow::Result<(String, HashMap<String, f64>)
     Ok(res)
 }
 
-/// Wraps most functions in `nexsys::parsing`, returning either an error that 
-/// prevents the code from being solvable or the intermediate language representation
-/// of the `.nxs`-formatted code.
-/// 
-/// This also mutates the given `ctx` and `declared` arguments, adding any found constant or 
-pub fn compile(code: &str, ctx: &mut ContextHashMap, declared: &mut HashMap<String, [f64; 3]>) -> anyhow::Result<String> 
-{    
-    let sys_domains: HashMap<String, [f64; 2]>;
-    let sys_guesses: HashMap<String, f64>;
-    let sys_consts:  HashMap<String, f64>;
-    
-    let mut nil = comments(code); 
-
-    // Copy-paste all common engineering constants (this happens first so users can rename constants)
-    nil = consts(&nil)?;
-
-    // Copy-paste any unit conversions (this happens second so they can be used in const definitions)
-    nil = conversions(&nil)?;
-
-    // Set all constants used in the solution
-    (nil, sys_consts) = const_values(&nil)?;
-    for (var, val) in sys_consts
-    {
-        ctx.add_const_to_ctx(&var, val);
-    }
+/// Copies one line of `.nxs` code into `out` in a single scan, stripping
+/// `//` comments and substituting `#constant` and `[from->to]` tokens as
+/// they are encountered.
+fn substitute_inline(line: &str, out: &mut String) -> anyhow::Result<()>
+{
+    let known_consts = const_table();
+    let mut rest = line;
 
-    // Set all domains for variables in the solution
-    (nil, sys_domains) = domains(&nil);
-    for (var, bounds) in sys_domains
+    while let Some(i) = rest.find(['/', '#', '['])
     {
-        if let Some(var_info) = declared.get_mut(&var)
+        out.push_str(&rest[..i]);
+        let tail = &rest[i..];
+
+        // A comment runs to the end of the line
+        if tail.starts_with("//")
         {
-            var_info[1] = bounds[0];
-            var_info[2] = bounds[1];
+            return Ok(());
         }
-        else 
+
+        // A '#' starts an engineering-constant token like "#pi"
+        if let Some(name) = tail.strip_prefix('#')
+        {
+            let len = name.find(|c: char| !(c.is_ascii_alphabetic() || c == '_'))
+                .unwrap_or(name.len());
+            if len > 0
+            {
+                match known_consts.get(&tail[..1 + len])
+                {
+                    Some(c) => out.push_str(&c.to_string()),
+                    None => return Err(ConstFormatError.into()),
+                }
+                rest = &tail[1 + len..];
+                continue;
+            }
+        }
+
+        // A '[' may open a unit conversion like "[in->cm]"
+        if tail.starts_with('[')
         {
-            declared.insert(var, [1.0, bounds[0], bounds[1]]);
+            if let Some(end) = tail.find(']')
+            {
+                let inner = &tail[1..end];
+                if let Some((fro, to)) = inner.split_once("->")
+                {
+                    let legal = |u: &str| !u.is_empty() && u.chars()
+                        .all(|c| c.is_ascii_alphanumeric() || "_^/-".contains(c));
+                    if legal(fro) && legal(to)
+                    {
+                        out.push_str(&convert(fro, to)?.to_string());
+                        rest = &tail[end + 1..];
+                        continue;
+                    }
+                }
+            }
         }
+
+        // A lone '/', '#', or non-conversion '[' passes through untouched
+        out.push_str(&tail[..1]);
+        rest = &tail[1..];
+    }
+    out.push_str(rest);
+    Ok(())
+}
+
+/// Compiles `.nxs` code from a buffered reader into the intermediate
+/// language representation in a single streaming pass.
+///
+/// Where `compile` works by stacked whole-text rewrites — each pass
+/// reallocating a fresh copy of the entire deck — this reads the source
+/// line by line, recognizes comments, `#` constants, bracketed unit
+/// conversions, and the `const`/`guess`/`keep` directives in one scan,
+/// and appends the surviving text to a single output buffer. Only the
+/// conditional blocks, whose syntax spans lines, are formatted against
+/// the assembled buffer afterwards. Large generated decks never need to
+/// be materialized in memory before compilation starts.
+pub fn compile_stream<R: BufRead>(reader: R, ctx: &mut ContextHashMap, declared: &mut HashMap<String, [f64; 3]>) -> anyhow::Result<String>
+{
+    lazy_static!
+    {
+        static ref CONST_RE: Regex = nexsys_regex(r"(?i)const +(@V) *= *(@N)");
+        static ref GUESS_RE: Regex = nexsys_regex(r"(?i)guess +(@N) +for +(@V)");
+        static ref KEEP_RE:  Regex = nexsys_regex(r"(?i)keep +(@V) +on +\[ *(@N), *(@N) *\]");
     }
 
-    // Set all initial guesses for variables in the solution
-    (nil, sys_guesses) = guess_values(&nil);
-    for (var, guess) in sys_guesses
+    let mut output = String::new();
+    let mut expanded = String::new();
+
+    for line in reader.lines()
     {
-        if let Some(var_info) = declared.get_mut(&var)
+        expanded.clear();
+        substitute_inline(&line?, &mut expanded)?;
+        let mut kept = std::mem::take(&mut expanded);
+
+        // Set all constants used in the solution
+        while let Some(c) = CONST_RE.captures(&kept)
         {
-            var_info[0] = guess;
+            ctx.add_const_to_ctx(
+                c.get(1).unwrap().as_str(),
+                eval_str(c.get(2).unwrap().as_str())?
+            );
+            kept = kept.replace(c.get(0).unwrap().as_str(), "");
         }
-        else 
+
+        // Set all domains for variables in the solution
+        while let Some(d) = KEEP_RE.captures(&kept)
         {
-            declared.insert(var, [guess, f64::NEG_INFINITY, f64::INFINITY]);
+            let var = d.get(1).unwrap().as_str().to_owned();
+            let bounds: [f64; 2] = [
+                d.get(2).unwrap().as_str().parse()
+                    .expect("failed to parse first number in domain declaration"),
+                d.get(3).unwrap().as_str().parse()
+                    .expect("failed to parse second number in domain declaration"),
+            ];
+            if let Some(var_info) = declared.get_mut(&var)
+            {
+                var_info[1] = bounds[0];
+                var_info[2] = bounds[1];
+            }
+            else
+            {
+                declared.insert(var, [1.0, bounds[0], bounds[1]]);
+            }
+            kept = kept.replace(d.get(0).unwrap().as_str(), "");
         }
+
+        // Set all initial guesses for variables in the solution
+        while let Some(g) = GUESS_RE.captures(&kept)
+        {
+            let var = g.get(2).unwrap().as_str().to_owned();
+            let guess: f64 = g.get(1).unwrap().as_str().parse()
+                .expect("failed to parse number in guess declaration");
+            if let Some(var_info) = declared.get_mut(&var)
+            {
+                var_info[0] = guess;
+            }
+            else
+            {
+                declared.insert(var, [guess, f64::NEG_INFINITY, f64::INFINITY]);
+            }
+            kept = kept.replace(g.get(0).unwrap().as_str(), "");
+        }
+
+        output.push_str(&kept);
+        output.push('\n');
+        expanded = kept;
     }
 
     // Format all conditional statements. (this happens last since most information is needed in order to evaluate the expression)
-    nil = conditionals(&nil)?;
+    conditionals(&output)
+}
 
-    Ok(nil)
+/// Wraps most functions in `nexsys::parsing`, returning either an error that
+/// prevents the code from being solvable or the intermediate language representation
+/// of the `.nxs`-formatted code.
+///
+/// This also mutates the given `ctx` and `declared` arguments, adding any found constant or
+pub fn compile(code: &str, ctx: &mut ContextHashMap, declared: &mut HashMap<String, [f64; 3]>) -> anyhow::Result<String>
+{
+    compile_stream(code.as_bytes(), ctx, declared)
 }
\ No newline at end of file
@@ -77,4 +77,64 @@ fn test_unit_data() {
     // println!("{}",_ud["VOLUMETRIC FLOW"]["m^3/s"]);
     // println!("{}",_ud["VOLUMETRIC FLOW"]["gpm"]);
     // println!("{}",_ud["VELOCITY"]["mph"]);
-}
\ No newline at end of file
+}
+#[test]
+fn test_streaming_preprocessor() {
+    use std::collections::HashMap;
+    use geqslib::shunting::new_context;
+    use nexsys::parsing::compile_stream;
+
+    let my_sys = b"
+keep x on [0, 100]
+guess 3 for y // directives and comments vanish
+const nine = 9
+
+x + y = nine * [in->cm] / 2.54
+x - y = 4 - #pi + #pi
+";
+
+    let mut ctx = new_context();
+    let mut declared = HashMap::new();
+    let compiled = compile_stream(&my_sys[..], &mut ctx, &mut declared).unwrap();
+
+    assert!(compiled.contains("x + y = nine * 2.54 / 2.54"));
+    assert!(!compiled.contains("//"));
+    assert!(!compiled.contains("keep"));
+    assert!(!compiled.contains("guess"));
+    assert_eq!(declared["x"], [1.0, 0.0, 100.0]);
+    assert_eq!(declared["y"][0], 3.0);
+}
+
+#[test]
+fn test_interned_unit_and_const_tables() {
+    use nexsys::units::{const_table, convert, unit_table};
+
+    // Every call sees the same once-initialized tables
+    assert!(std::ptr::eq(unit_table(), unit_table()));
+    assert!(std::ptr::eq(const_table(), const_table()));
+
+    // Lookups against the interned tables behave like the old scan
+    assert!((convert("in", "cm").unwrap() - 2.54).abs() < 1e-12);
+    assert!(convert("in", "not_a_real_unit").is_err());
+}
+
+#[test]
+fn test_solution_cache_distinguishes_digit_suffixed_variables() {
+    use nexsys::SolutionCache;
+
+    let mut cache = SolutionCache::new();
+
+    // Both decks mask to the same shape if the digits in x1/x2 are
+    // treated as literals, and both leave y free to land on either root
+    // of a square — so a key collision would seed the second deck's y
+    // from the first deck's negative solution.
+    let deck_a = "guess -5 for y \n y ^ 2 = x1 \n x1 = 25";
+    let deck_b = "y ^ 2 = x2 \n x2 = 25";
+
+    let (_, soln_a) = cache.solve(deck_a, 0.0001, 100).unwrap();
+    assert!((soln_a["y"] + 5.0).abs() < 0.001);
+
+    // Uncached, y starts from the default guess and finds the positive root
+    let (_, soln_b) = cache.solve(deck_b, 0.0001, 100).unwrap();
+    assert!((soln_b["y"] - 5.0).abs() < 0.001);
+}